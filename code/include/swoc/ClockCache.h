@@ -0,0 +1,295 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Apache Software Foundation 2019
+/** @file
+
+  Thread safe fixed size cache with CLOCK replacement.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+#include "swoc/swoc_version.h"
+#include "swoc/IntrusiveDList.h"
+#include "swoc/IntrusiveHashMap.h"
+#include "swoc/ShardedHashMap.h"
+#include "swoc/MemArena.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+/** Thread safe fixed size key / value cache.
+ *
+ * @tparam K Key type.
+ * @tparam V Value type.
+ * @tparam N Number of shards, which must be a power of 2.
+ * @tparam HASH Hash functor for @a K.
+ *
+ * The cache holds at most a fixed number of items. If an item is added when full, an item is
+ * evicted using the CLOCK algorithm. Each item has a reference bit which is set when the item is
+ * retrieved. The items are kept in a circular list with a "hand". To evict, the hand is advanced
+ * past items with the reference bit set, clearing it, and the first item without the bit set is
+ * evicted.
+ *
+ * This approximates LRU, but retrieving an item only sets a bit, it does not move the item in a
+ * list. Therefore retrieval needs only a shared lock, and readers do not block each other. New
+ * items are added just behind the hand with the bit clear, so items that are used only once (e.g.
+ * from a scan) are evicted before items that have been retrieved since they were added.
+ *
+ * The items are divided among @a N shards by hash value, the same as @c ShardedHashMap, each with
+ * its own lock, item list, and memory. Items are allocated from a @c FixedArena in the shard and recycled on eviction.
+ */
+template <typename K, typename V, size_t N = 16, typename HASH = std::hash<K>> class ClockCache {
+  using self_type = ClockCache; ///< Self reference type.
+  static_assert(N > 0 && (N & (N - 1)) == 0, "The number of shards must be a power of 2");
+
+public:
+  using key_type   = K; ///< Key type.
+  using value_type = V; ///< Value type.
+
+  /// Number of shards.
+  static constexpr size_t SHARD_COUNT = N;
+
+  /** Construct with a maximum number of items.
+   *
+   * @param max Maximum number of items.
+   *
+   * The limit is divided evenly among the shards, rounded up. Because the items are not evenly
+   * distributed among the shards, evictions may start with fewer than @a max items.
+   */
+  explicit ClockCache(size_t max);
+
+  /// Destructor - destroys the items.
+  ~ClockCache();
+
+  /** Insert or update an item.
+   *
+   * @param key Key for the item.
+   * @param value Value for the item.
+   * @return @a this
+   *
+   * If @a key is already in the cache its value is updated and the item is marked as referenced.
+   * Otherwise a new item is added, evicting an item if the shard is full.
+   */
+  self_type &insert(K const &key, V value);
+
+  /** Retrieve a value.
+   *
+   * @param key Key for the item.
+   * @return A copy of the value, or nothing if @a key is not in the cache.
+   *
+   * The item is marked as referenced.
+   */
+  std::optional<V> retrieve(K const &key) const;
+
+  /** Remove an item.
+   *
+   * @param key Key for the item.
+   * @return @c true if @a key was in the cache and removed, @c false if not.
+   */
+  bool erase(K const &key);
+
+  /// Number of items in the cache.
+  /// This is only an approximation if other threads are changing the cache.
+  size_t count() const;
+
+  /// Maximum number of items in the cache.
+  size_t capacity() const;
+
+protected:
+  /// A cached item.
+  struct Item {
+    using self_type = Item;
+    struct Links {
+      self_type *_next = nullptr;
+      self_type *_prev = nullptr;
+    };
+
+    K _key;                                       ///< Key.
+    V _value;                                     ///< Value.
+    mutable std::atomic<bool> _referenced{false}; ///< Retrieved since the hand passed.
+    Links _map;                                   ///< Hash map links.
+    Links _clock;                                 ///< Clock list links.
+
+    Item(K const &key, V &&value) : _key(key), _value(std::move(value)) {}
+  };
+
+  /// Linkage for the clock list.
+  struct Linkage {
+    static Item *&
+    next_ptr(Item *item) {
+      return item->_clock._next;
+    }
+    static Item *&
+    prev_ptr(Item *item) {
+      return item->_clock._prev;
+    }
+  };
+  using List = IntrusiveDList<Linkage>;
+
+  /// Descriptor for the hash map.
+  struct Hashing {
+    static Item *&
+    next_ptr(Item *item) {
+      return item->_map._next;
+    }
+    static Item *&
+    prev_ptr(Item *item) {
+      return item->_map._prev;
+    }
+    static K const &
+    key_of(Item *item) {
+      return item->_key;
+    }
+    static size_t
+    hash_of(K const &key) {
+      return HASH{}(key);
+    }
+    static bool
+    equal(K const &lhs, K const &rhs) {
+      return lhs == rhs;
+    }
+  };
+  using Table = IntrusiveHashMap<Hashing>;
+
+  /// Independent part of the cache, aligned to avoid false sharing between shards.
+  struct alignas(64) Shard {
+    mutable std::shared_mutex _mutex; ///< Lock for the shard.
+    Table _table;                     ///< Items by key.
+    List _clock;                      ///< Items in clock order.
+    Item *_hand = nullptr;            ///< Next item to check for eviction.
+    MemArena _arena;                  ///< Memory for items.
+    FixedArena<Item> _items{_arena};  ///< Item allocator.
+
+    /// Find an item to evict and remove it from the shard.
+    Item *evict();
+  };
+
+  size_t _shard_max;            ///< Maximum number of items in a shard.
+  std::array<Shard, N> _shards; ///< Shards.
+
+  /// @return The shard for @a key.
+  Shard &shard_for(K const &key) const;
+};
+
+// --- Implementation ---
+
+template <typename K, typename V, size_t N, typename HASH>
+ClockCache<K, V, N, HASH>::ClockCache(size_t max) : _shard_max(std::max<size_t>(1, (max + N - 1) / N)) {
+  for (auto &shard : _shards) {
+    shard._table.set_incremental_expansion(true);
+  }
+}
+
+template <typename K, typename V, size_t N, typename HASH> ClockCache<K, V, N, HASH>::~ClockCache() {
+  for (auto &shard : _shards) {
+    shard._clock.apply([](Item *item) { item->~Item(); });
+  }
+}
+
+template <typename K, typename V, size_t N, typename HASH>
+auto
+ClockCache<K, V, N, HASH>::shard_for(K const &key) const -> Shard & {
+  return const_cast<Shard &>(_shards[ShardedHashMap<Hashing, N>::shard_index(Hashing::hash_of(key))]);
+}
+
+template <typename K, typename V, size_t N, typename HASH>
+auto
+ClockCache<K, V, N, HASH>::Shard::evict() -> Item * {
+  // Every item passed is cleared, so this takes at most one trip around the clock.
+  while (true) {
+    if (nullptr == _hand) {
+      _hand = _clock.head();
+    }
+    Item *item = _hand;
+    _hand      = Linkage::next_ptr(item);
+    if (item->_referenced.load(std::memory_order_relaxed)) {
+      item->_referenced.store(false, std::memory_order_relaxed);
+    } else {
+      _table.erase(item);
+      _clock.erase(item);
+      return item;
+    }
+  }
+}
+
+template <typename K, typename V, size_t N, typename HASH>
+auto
+ClockCache<K, V, N, HASH>::insert(K const &key, V value) -> self_type & {
+  auto &shard = this->shard_for(key);
+  std::unique_lock lock(shard._mutex);
+  if (auto spot = shard._table.find(key); spot != shard._table.end()) {
+    spot->_value = std::move(value);
+    spot->_referenced.store(true, std::memory_order_relaxed);
+    return *this;
+  }
+
+  if (shard._clock.count() >= _shard_max) {
+    shard._items.destroy(shard.evict());
+  }
+  Item *item = shard._items.make(key, std::move(value));
+  shard._table.insert(item);
+  // Just behind the hand, so this is the last item checked.
+  if (shard._hand) {
+    shard._clock.insert_before(shard._hand, item);
+  } else {
+    shard._clock.append(item);
+  }
+  return *this;
+}
+
+template <typename K, typename V, size_t N, typename HASH>
+auto
+ClockCache<K, V, N, HASH>::retrieve(K const &key) const -> std::optional<V> {
+  auto &shard = this->shard_for(key);
+  std::shared_lock lock(shard._mutex);
+  if (auto spot = shard._table.find(key); spot != shard._table.end()) {
+    // Avoid writing the cache line if the bit is already set.
+    if (!spot->_referenced.load(std::memory_order_relaxed)) {
+      spot->_referenced.store(true, std::memory_order_relaxed);
+    }
+    return spot->_value;
+  }
+  return {};
+}
+
+template <typename K, typename V, size_t N, typename HASH>
+bool
+ClockCache<K, V, N, HASH>::erase(K const &key) {
+  auto &shard = this->shard_for(key);
+  std::unique_lock lock(shard._mutex);
+  if (auto spot = shard._table.find(key); spot != shard._table.end()) {
+    Item *item = spot;
+    if (shard._hand == item) {
+      shard._hand = Linkage::next_ptr(item);
+    }
+    shard._table.erase(spot);
+    shard._clock.erase(item);
+    shard._items.destroy(item);
+    return true;
+  }
+  return false;
+}
+
+template <typename K, typename V, size_t N, typename HASH>
+size_t
+ClockCache<K, V, N, HASH>::count() const {
+  size_t zret = 0;
+  for (auto &shard : _shards) {
+    std::shared_lock lock(shard._mutex);
+    zret += shard._clock.count();
+  }
+  return zret;
+}
+
+template <typename K, typename V, size_t N, typename HASH>
+size_t
+ClockCache<K, V, N, HASH>::capacity() const {
+  return _shard_max * N;
+}
+
+}} // namespace swoc::SWOC_VERSION_NS
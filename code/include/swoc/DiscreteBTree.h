@@ -0,0 +1,915 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+
+    B+ tree storage for @c DiscreteSpace.
+
+    Ranges are packed in to leaf arrays sized to a small number of cache lines. Leaves are linked
+    for iteration and interior nodes hold only the minimum values needed to route a search. This
+    costs much less memory per range than the red/black tree and a lookup touches far fewer cache
+    lines.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <memory>
+
+#include "swoc/swoc_version.h"
+#include "swoc/DiscreteRange.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+
+/** Storage selector for @c DiscreteSpace - a B+ tree with packed leaves.
+ *
+ * The values here determine the size of the tree nodes and therefore the fanout.
+ */
+struct DiscreteSpaceBTree {
+  static constexpr size_t CACHE_LINE = 64; ///< Size of a cache line.
+  static constexpr size_t NODE_LINES = 4;  ///< Cache lines per tree node.
+};
+
+/** B+ tree based @c DiscreteSpace.
+ *
+ * This has the same semantics as the red/black tree version for @c mark, @c fill, @c blend, @c erase
+ * and @c find. Adjacent ranges with equal payloads are always coalesced.
+ *
+ * The ranges are stored by value in the leaves and therefore move as the tree is modified. Unlike
+ * the red/black tree version, iterators are invalidated by any modification of the space.
+ *
+ * @c PAYLOAD must be default constructible and move assignable.
+ */
+template <typename METRIC, typename PAYLOAD> class DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree> {
+  using self_type = DiscreteSpace;
+
+protected:
+  using metric_type  = METRIC;  ///< Export.
+  using payload_type = PAYLOAD; ///< Export.
+  using range_type   = DiscreteRange<METRIC>;
+
+  /// Node size in bytes.
+  static constexpr size_t NODE_SIZE = DiscreteSpaceBTree::CACHE_LINE * DiscreteSpaceBTree::NODE_LINES;
+
+  /// Data common to leaf and interior nodes.
+  struct NodeBase {
+    unsigned _count = 0; ///< Number of ranges (leaf) or children (interior).
+    bool _leaf_p;        ///< Node type flag.
+
+    explicit NodeBase(bool leaf_p) : _leaf_p(leaf_p) {}
+  };
+
+  /// Maximum number of ranges in a leaf.
+  static constexpr unsigned LEAF_N =
+    std::max<size_t>(4, (NODE_SIZE - sizeof(NodeBase) - 2 * sizeof(void *)) / (2 * sizeof(METRIC) + sizeof(PAYLOAD)));
+  /// Minimum number of ranges in a non-root leaf.
+  static constexpr unsigned LEAF_MIN = LEAF_N / 2;
+  /// Maximum number of children of an interior node.
+  static constexpr unsigned INNER_N = std::max<size_t>(4, (NODE_SIZE - sizeof(NodeBase)) / (sizeof(METRIC) + sizeof(void *)));
+  /// Minimum number of children of a non-root interior node.
+  static constexpr unsigned INNER_MIN = INNER_N / 2;
+
+  /// Leaf node - the ranges and payloads, stored as parallel arrays.
+  struct Leaf : public NodeBase {
+    Leaf() : NodeBase(true) {}
+
+    Leaf *_next = nullptr;     ///< Next leaf.
+    Leaf *_prev = nullptr;     ///< Previous leaf.
+    METRIC _min[LEAF_N];       ///< Range minimums.
+    METRIC _max[LEAF_N];       ///< Range maximums.
+    PAYLOAD _payload[LEAF_N]{}; ///< Range payloads.
+  };
+
+  /** Interior node.
+   *
+   * @a _key[i] is the separator between @a _child[i] and @a _child[i+1]. The minimum of every range
+   * in the subtree under @a _child[i] is in the half open interval <tt>[_key[i-1], _key[i])</tt>.
+   */
+  struct Inner : public NodeBase {
+    Inner() : NodeBase(false) {}
+
+    METRIC _key[INNER_N - 1];   ///< Separator keys.
+    NodeBase *_child[INNER_N]; ///< Child nodes.
+  };
+
+  /// Descent path from the root to a leaf.
+  struct Path {
+    static constexpr unsigned MAX_DEPTH = 32; ///< Far more than can fit in memory.
+    Inner *_inner[MAX_DEPTH];                 ///< Interior nodes from the root.
+    unsigned _idx[MAX_DEPTH];                 ///< Child index taken at each interior node.
+    unsigned _depth = 0;                      ///< Number of interior nodes.
+  };
+
+public:
+  class iterator;
+
+  /** A reference to a range in the space.
+   *
+   * This is the value type for iteration. The range is constant but the payload can be updated.
+   */
+  class Entry {
+    friend class DiscreteSpace;
+    friend class iterator;
+
+  public:
+    /// @return The range.
+    range_type
+    range() const {
+      return {this->min(), this->max()};
+    }
+
+    /// @return The minimum of the range.
+    METRIC const &
+    min() const {
+      return _leaf->_min[_idx];
+    }
+
+    /// @return The maximum of the range.
+    METRIC const &
+    max() const {
+      return _leaf->_max[_idx];
+    }
+
+    /// @return The payload of the range.
+    PAYLOAD &
+    payload() const {
+      return _leaf->_payload[_idx];
+    }
+
+    /// @return @c true if this refers to a range, @c false if not.
+    explicit operator bool() const {
+      return _leaf != nullptr;
+    }
+
+  protected:
+    Leaf *_leaf   = nullptr; ///< Containing leaf.
+    unsigned _idx = 0;       ///< Index in @a _leaf.
+
+    Entry() = default;
+    Entry(Leaf *leaf, unsigned idx) : _leaf(leaf), _idx(idx) {}
+
+    /// Writable access to the maximum.
+    METRIC &
+    max_ref() const {
+      return _leaf->_max[_idx];
+    }
+  };
+
+  /// Bidirectional iterator over the ranges in order.
+  class iterator {
+    using self_type = iterator;
+    friend class DiscreteSpace;
+
+  public:
+    using value_type = Entry const; ///< Import for API compliance.
+    // STL algorithm compliance.
+    using iterator_category = std::bidirectional_iterator_tag;
+    using pointer           = value_type *;
+    using reference         = value_type &;
+    using difference_type   = int;
+
+    /// Default constructor.
+    iterator() = default;
+
+    /// Pre-increment.
+    /// Move to the next range.
+    /// @return The iterator.
+    self_type &operator++();
+
+    /// Pre-decrement.
+    /// Move to the previous range.
+    /// @return The iterator.
+    self_type &operator--();
+
+    /// Post-increment.
+    /// @return The iterator value before the increment.
+    self_type
+    operator++(int) {
+      self_type zret{*this};
+      ++*this;
+      return zret;
+    }
+
+    /// Post-decrement.
+    /// @return The iterator value before the decrement.
+    self_type
+    operator--(int) {
+      self_type zret{*this};
+      --*this;
+      return zret;
+    }
+
+    /// Dereference.
+    /// @return A reference to the range entry.
+    reference
+    operator*() const {
+      return _entry;
+    }
+
+    /// Dereference.
+    /// @return A pointer to the range entry.
+    pointer
+    operator->() const {
+      return &_entry;
+    }
+
+    /// Equality
+    bool
+    operator==(self_type const &that) const {
+      return _entry._leaf == that._entry._leaf && _entry._idx == that._entry._idx;
+    }
+
+    /// Inequality
+    bool
+    operator!=(self_type const &that) const {
+      return !(*this == that);
+    }
+
+  protected:
+    DiscreteSpace const *_space = nullptr; ///< Containing space, needed to back up from @c end.
+    Entry _entry;                          ///< Current range.
+
+    iterator(DiscreteSpace const *space, Entry const &entry) : _space(space), _entry(entry) {}
+  };
+
+  using const_iterator = iterator;
+
+  DiscreteSpace() = default;
+
+  ~DiscreteSpace();
+
+  /** Set the @a payload for a @a range
+   *
+   * @param range Range to mark.
+   * @param payload Payload to set.
+   * @return @a this
+   *
+   * Values in @a range are set to @a payload regardless of the current state.
+   */
+  self_type &mark(range_type const &range, PAYLOAD const &payload);
+
+  /** Erase a @a range.
+   *
+   * @param range Range to erase.
+   * @return @a this
+   *
+   * All values in @a range are removed from the space.
+   */
+  self_type &erase(range_type const &range);
+
+  /** Blend a @a color to a @a range.
+   *
+   * @tparam F Functor to blend payloads.
+   * @tparam U type to blend in to payloads.
+   * @param range Range for blending.
+   * @param color Payload to blend.
+   * @param blender Functor to compute blended color.
+   * @return @a this
+   *
+   * See the red/black tree version for a description of the blending semantics.
+   */
+  template <typename F, typename U = PAYLOAD> self_type &blend(range_type const &range, U const &color, F &&blender);
+
+  /** Fill @a range with @a payload.
+   *
+   * @param range Range to fill.
+   * @param payload Payload to use.
+   * @return @a this
+   *
+   * Values in @a range that do not have a payload are set to @a payload. Values in the space are
+   * not changed.
+   */
+  self_type &fill(range_type const &range, PAYLOAD const &payload);
+
+  /** Find the payload at @a metric.
+   *
+   * @param metric The metric for which to search.
+   * @return An iterator for the range containing @a metric, or @c end if not found.
+   */
+  iterator find(METRIC const &metric) const;
+
+  /// @return The number of distinct ranges.
+  size_t
+  count() const {
+    return _count;
+  }
+
+  iterator
+  begin() const {
+    return {this, this->head()};
+  }
+
+  iterator
+  end() const {
+    return {this, Entry{}};
+  }
+
+  /// Remove all ranges.
+  void clear();
+
+protected:
+  NodeBase *_root = nullptr;          ///< Root node.
+  Leaf *_head     = nullptr;          ///< First leaf.
+  Leaf *_tail     = nullptr;          ///< Last leaf.
+  size_t _count   = 0;                ///< Number of ranges.
+  swoc::MemArena _arena{4000};        ///< Memory Storage.
+  swoc::FixedArena<Leaf> _leaf_fa{_arena};   ///< Leaf allocator and free list.
+  swoc::FixedArena<Inner> _inner_fa{_arena}; ///< Interior node allocator and free list.
+
+  /** Descend from the root to the leaf for @a metric.
+   *
+   * @param metric Search value.
+   * @param path [out] Descent path, if not @c nullptr.
+   * @return The leaf whose routing interval contains @a metric.
+   */
+  Leaf *descend(METRIC const &metric, Path *path = nullptr) const;
+
+  /** Find the lower bound range for @a target.
+   *
+   * @param target Lower bound value.
+   * @return The rightmost range that starts at or before @a target, or an invalid entry if all ranges
+   * start after @a target.
+   */
+  Entry lower_bound(METRIC const &target) const;
+
+  /// @return The first range.
+  Entry head() const;
+
+  /// @return The range after @a spot, or an invalid entry if @a spot is the last range.
+  Entry next(Entry const &spot) const;
+
+  /** Insert a range in to a gap.
+   *
+   * The range must not overlap any range in the space.
+   */
+  void insert(METRIC const &min, METRIC const &max, PAYLOAD const &payload);
+
+  /** Insert a range in to a gap, coalescing with adjacent ranges with the same payload.
+   *
+   * The range must not overlap any range in the space.
+   */
+  void place(METRIC const &min, METRIC const &max, PAYLOAD const &payload);
+
+  /// Remove the range with the minimum @a key.
+  void remove(METRIC key);
+
+  /** Change the minimum of a range.
+   *
+   * @param spot Range to update.
+   * @param min New minimum.
+   *
+   * The range must remain disjoint from its neighbors.
+   */
+  void assign_min(Entry const &spot, METRIC const &min);
+
+  /// Add the leaf @a r after the leaf @a l in the leaf list.
+  void link_after(Leaf *l, Leaf *r);
+
+  /// Remove the leaf @a l from the leaf list and free it.
+  void unlink(Leaf *l);
+
+  /// Insert separator @a key and @a child in to the parent at @a depth in @a path.
+  void insert_child(Path &path, unsigned depth, METRIC const &key, NodeBase *child);
+
+  /// Restore the occupancy invariant for the interior node at @a depth in @a path.
+  void rebalance(Path &path, unsigned depth);
+
+  /// Destruct the subtree rooted at @a n.
+  void destroy(NodeBase *n);
+
+  /// Shift the ranges at and after @a idx in @a leaf up by one.
+  static void leaf_open(Leaf *leaf, unsigned idx);
+
+  /// Remove the range at @a idx in @a leaf.
+  static void leaf_close(Leaf *leaf, unsigned idx);
+
+  /// Move the range at @a src_idx in @a src to @a dst_idx in @a dst.
+  static void leaf_move(Leaf *dst, unsigned dst_idx, Leaf *src, unsigned src_idx);
+
+  /// Remove the child at @a idx, and the separator to its left, from @a inner.
+  static void inner_erase(Inner *inner, unsigned idx);
+};
+
+// ---
+
+template <typename METRIC, typename PAYLOAD>
+auto
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::iterator::operator++() -> self_type & {
+  if (++_entry._idx >= _entry._leaf->_count) {
+    _entry._leaf = _entry._leaf->_next;
+    _entry._idx  = 0;
+  }
+  return *this;
+}
+
+template <typename METRIC, typename PAYLOAD>
+auto
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::iterator::operator--() -> self_type & {
+  if (_entry._leaf == nullptr) {
+    _entry._leaf = _space->_tail;
+    _entry._idx  = _entry._leaf->_count - 1;
+  } else if (_entry._idx > 0) {
+    --_entry._idx;
+  } else {
+    _entry._leaf = _entry._leaf->_prev;
+    _entry._idx  = _entry._leaf->_count - 1;
+  }
+  return *this;
+}
+
+template <typename METRIC, typename PAYLOAD> DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::~DiscreteSpace() {
+  // Destruct all the payloads - the nodes themselves are in the arena and disappear with it.
+  this->destroy(_root);
+}
+
+template <typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::clear() {
+  this->destroy(_root);
+  _root = nullptr;
+  _head = _tail = nullptr;
+  _count        = 0;
+  _arena.clear();
+  _leaf_fa.clear();
+  _inner_fa.clear();
+}
+
+template <typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::destroy(NodeBase *n) {
+  if (n == nullptr) {
+    return;
+  }
+  if (n->_leaf_p) {
+    std::destroy_at(static_cast<Leaf *>(n));
+  } else {
+    auto inner = static_cast<Inner *>(n);
+    for (unsigned i = 0; i < inner->_count; ++i) {
+      this->destroy(inner->_child[i]);
+    }
+    std::destroy_at(inner);
+  }
+}
+
+template <typename METRIC, typename PAYLOAD>
+auto
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::descend(METRIC const &metric, Path *path) const -> Leaf * {
+  NodeBase *n = _root;
+  while (!n->_leaf_p) {
+    auto inner = static_cast<Inner *>(n);
+    unsigned idx = std::upper_bound(inner->_key, inner->_key + inner->_count - 1, metric) - inner->_key;
+    if (path) {
+      path->_inner[path->_depth] = inner;
+      path->_idx[path->_depth]   = idx;
+      ++path->_depth;
+    }
+    n = inner->_child[idx];
+  }
+  return static_cast<Leaf *>(n);
+}
+
+template <typename METRIC, typename PAYLOAD>
+auto
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::lower_bound(METRIC const &target) const -> Entry {
+  if (_root == nullptr) {
+    return {};
+  }
+
+  // Fast check for sequential insertion
+  if (_tail->_count > 0 && _tail->_max[_tail->_count - 1] < target) {
+    return {_tail, _tail->_count - 1};
+  }
+
+  auto leaf    = this->descend(target);
+  unsigned idx = std::upper_bound(leaf->_min, leaf->_min + leaf->_count, target) - leaf->_min;
+  if (idx > 0) {
+    return {leaf, idx - 1};
+  }
+  // Every range in the previous leaf starts before the routing interval for @a leaf.
+  if (leaf->_prev) {
+    return {leaf->_prev, leaf->_prev->_count - 1};
+  }
+  return {};
+}
+
+template <typename METRIC, typename PAYLOAD>
+auto
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::head() const -> Entry {
+  return (_head && _head->_count > 0) ? Entry{_head, 0} : Entry{};
+}
+
+template <typename METRIC, typename PAYLOAD>
+auto
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::next(Entry const &spot) const -> Entry {
+  if (spot._idx + 1 < spot._leaf->_count) {
+    return {spot._leaf, spot._idx + 1};
+  }
+  return spot._leaf->_next ? Entry{spot._leaf->_next, 0} : Entry{};
+}
+
+template <typename METRIC, typename PAYLOAD>
+auto
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::find(METRIC const &metric) const -> iterator {
+  auto spot = this->lower_bound(metric);
+  if (spot && !(spot.max() < metric)) {
+    return {this, spot};
+  }
+  return this->end();
+}
+
+template <typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::leaf_open(Leaf *leaf, unsigned idx) {
+  auto n = leaf->_count;
+  std::move_backward(leaf->_min + idx, leaf->_min + n, leaf->_min + n + 1);
+  std::move_backward(leaf->_max + idx, leaf->_max + n, leaf->_max + n + 1);
+  std::move_backward(leaf->_payload + idx, leaf->_payload + n, leaf->_payload + n + 1);
+}
+
+template <typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::leaf_close(Leaf *leaf, unsigned idx) {
+  auto n = leaf->_count;
+  std::move(leaf->_min + idx + 1, leaf->_min + n, leaf->_min + idx);
+  std::move(leaf->_max + idx + 1, leaf->_max + n, leaf->_max + idx);
+  std::move(leaf->_payload + idx + 1, leaf->_payload + n, leaf->_payload + idx);
+  leaf->_payload[n - 1] = PAYLOAD{}; // release anything held by the vacated payload.
+  --leaf->_count;
+}
+
+template <typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::leaf_move(Leaf *dst, unsigned dst_idx, Leaf *src, unsigned src_idx) {
+  dst->_min[dst_idx]     = src->_min[src_idx];
+  dst->_max[dst_idx]     = src->_max[src_idx];
+  dst->_payload[dst_idx] = std::move(src->_payload[src_idx]);
+}
+
+template <typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::inner_erase(Inner *inner, unsigned idx) {
+  auto n = inner->_count;
+  std::move(inner->_key + idx, inner->_key + n - 1, inner->_key + idx - 1);
+  std::move(inner->_child + idx + 1, inner->_child + n, inner->_child + idx);
+  --inner->_count;
+}
+
+template <typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::link_after(Leaf *l, Leaf *r) {
+  r->_prev = l;
+  r->_next = l->_next;
+  if (l->_next) {
+    l->_next->_prev = r;
+  } else {
+    _tail = r;
+  }
+  l->_next = r;
+}
+
+template <typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::unlink(Leaf *l) {
+  (l->_prev ? l->_prev->_next : _head) = l->_next;
+  (l->_next ? l->_next->_prev : _tail) = l->_prev;
+  _leaf_fa.destroy(l);
+}
+
+template <typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::insert(METRIC const &min, METRIC const &max, PAYLOAD const &payload) {
+  if (_root == nullptr) {
+    _root = _head = _tail = _leaf_fa.make();
+  }
+
+  Path path;
+  auto leaf    = this->descend(min, &path);
+  unsigned idx = std::upper_bound(leaf->_min, leaf->_min + leaf->_count, min) - leaf->_min;
+  ++_count;
+
+  Leaf *right = nullptr; // new leaf from a split, if any.
+  if (leaf->_count >= LEAF_N) {
+    // Split - move the upper half to a new leaf, then insert in the appropriate half.
+    static constexpr unsigned H = LEAF_N / 2;
+    right                       = _leaf_fa.make();
+    for (unsigned i = H; i < LEAF_N; ++i) {
+      leaf_move(right, i - H, leaf, i);
+      leaf->_payload[i] = PAYLOAD{};
+    }
+    right->_count = LEAF_N - H;
+    leaf->_count  = H;
+    this->link_after(leaf, right);
+    if (idx > H) {
+      leaf = right;
+      idx -= H;
+    }
+  }
+
+  leaf_open(leaf, idx);
+  leaf->_min[idx]     = min;
+  leaf->_max[idx]     = max;
+  leaf->_payload[idx] = payload;
+  ++leaf->_count;
+
+  if (right) {
+    this->insert_child(path, path._depth, right->_min[0], right);
+  }
+}
+
+template <typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::insert_child(Path &path, unsigned depth, METRIC const &key, NodeBase *child) {
+  if (depth == 0) { // split the root.
+    auto root       = _inner_fa.make();
+    root->_child[0] = _root;
+    root->_child[1] = child;
+    root->_key[0]   = key;
+    root->_count    = 2;
+    _root           = root;
+    return;
+  }
+
+  auto inner   = path._inner[depth - 1];
+  unsigned idx = path._idx[depth - 1] + 1; // position for @a child.
+  auto n       = inner->_count;
+
+  if (n < INNER_N) {
+    std::move_backward(inner->_key + idx - 1, inner->_key + n - 1, inner->_key + n);
+    std::move_backward(inner->_child + idx, inner->_child + n, inner->_child + n + 1);
+    inner->_key[idx - 1] = key;
+    inner->_child[idx]   = child;
+    ++inner->_count;
+    return;
+  }
+
+  // Full - merge in to temporaries and split, promoting the middle key.
+  METRIC keys[INNER_N];
+  NodeBase *kids[INNER_N + 1];
+  std::copy(inner->_key, inner->_key + idx - 1, keys);
+  keys[idx - 1] = key;
+  std::copy(inner->_key + idx - 1, inner->_key + n - 1, keys + idx);
+  std::copy(inner->_child, inner->_child + idx, kids);
+  kids[idx] = child;
+  std::copy(inner->_child + idx, inner->_child + n, kids + idx + 1);
+
+  static constexpr unsigned H = (INNER_N + 1) / 2; // children left in @a inner.
+  auto right                  = _inner_fa.make();
+  std::copy(keys, keys + H - 1, inner->_key);
+  std::copy(kids, kids + H, inner->_child);
+  inner->_count = H;
+  std::copy(keys + H, keys + INNER_N, right->_key);
+  std::copy(kids + H, kids + INNER_N + 1, right->_child);
+  right->_count = INNER_N + 1 - H;
+
+  this->insert_child(path, depth - 1, keys[H - 1], right);
+}
+
+template <typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::remove(METRIC key) {
+  Path path;
+  auto leaf    = this->descend(key, &path);
+  unsigned idx = std::lower_bound(leaf->_min, leaf->_min + leaf->_count, key) - leaf->_min;
+  leaf_close(leaf, idx);
+  --_count;
+
+  if (path._depth == 0 || leaf->_count >= LEAF_MIN) {
+    return; // root leaf, or still sufficiently full.
+  }
+
+  auto parent  = path._inner[path._depth - 1];
+  unsigned cdx = path._idx[path._depth - 1];
+  Leaf *left   = cdx > 0 ? static_cast<Leaf *>(parent->_child[cdx - 1]) : nullptr;
+  Leaf *right  = cdx + 1 < parent->_count ? static_cast<Leaf *>(parent->_child[cdx + 1]) : nullptr;
+
+  if (left && left->_count > LEAF_MIN) { // borrow from the left.
+    leaf_open(leaf, 0);
+    leaf_move(leaf, 0, left, left->_count - 1);
+    leaf_close(left, left->_count - 1);
+    ++leaf->_count;
+    parent->_key[cdx - 1] = leaf->_min[0];
+  } else if (right && right->_count > LEAF_MIN) { // borrow from the right.
+    leaf_move(leaf, leaf->_count++, right, 0);
+    leaf_close(right, 0);
+    parent->_key[cdx] = right->_min[0];
+  } else {
+    if (left) { // merge in to the left, dropping @a leaf.
+      right = leaf;
+      leaf  = left;
+    } else { // merge the right in to @a leaf.
+      ++cdx;
+    }
+    for (unsigned i = 0; i < right->_count; ++i) {
+      leaf_move(leaf, leaf->_count++, right, i);
+    }
+    this->unlink(right);
+    inner_erase(parent, cdx);
+    this->rebalance(path, path._depth - 1);
+  }
+}
+
+template <typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::rebalance(Path &path, unsigned depth) {
+  auto inner = path._inner[depth];
+  if (depth == 0) { // root - collapse if only one child.
+    if (inner->_count == 1) {
+      _root = inner->_child[0];
+      _inner_fa.destroy(inner);
+    }
+    return;
+  }
+
+  if (inner->_count >= INNER_MIN) {
+    return;
+  }
+
+  auto parent  = path._inner[depth - 1];
+  unsigned cdx = path._idx[depth - 1];
+  Inner *left  = cdx > 0 ? static_cast<Inner *>(parent->_child[cdx - 1]) : nullptr;
+  Inner *right = cdx + 1 < parent->_count ? static_cast<Inner *>(parent->_child[cdx + 1]) : nullptr;
+  auto n       = inner->_count;
+
+  if (left && left->_count > INNER_MIN) { // rotate the last child of @a left through the parent.
+    std::move_backward(inner->_key, inner->_key + n - 1, inner->_key + n);
+    std::move_backward(inner->_child, inner->_child + n, inner->_child + n + 1);
+    inner->_key[0]        = parent->_key[cdx - 1];
+    inner->_child[0]      = left->_child[left->_count - 1];
+    parent->_key[cdx - 1] = left->_key[left->_count - 2];
+    --left->_count;
+    ++inner->_count;
+  } else if (right && right->_count > INNER_MIN) { // rotate the first child of @a right through the parent.
+    inner->_key[n - 1] = parent->_key[cdx];
+    inner->_child[n]   = right->_child[0];
+    ++inner->_count;
+    parent->_key[cdx] = right->_key[0];
+    std::move(right->_key + 1, right->_key + right->_count - 1, right->_key);
+    std::move(right->_child + 1, right->_child + right->_count, right->_child);
+    --right->_count;
+  } else {
+    if (left) { // merge in to the left, dropping @a inner.
+      right = inner;
+      inner = left;
+      --cdx;
+    }
+    // Merge @a right in to @a inner, pulling down the separator.
+    n                  = inner->_count;
+    inner->_key[n - 1] = parent->_key[cdx];
+    std::copy(right->_key, right->_key + right->_count - 1, inner->_key + n);
+    std::copy(right->_child, right->_child + right->_count, inner->_child + n);
+    inner->_count += right->_count;
+    _inner_fa.destroy(right);
+    inner_erase(parent, cdx + 1);
+    this->rebalance(path, depth - 1);
+  }
+}
+
+template <typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::assign_min(Entry const &spot, METRIC const &min) {
+  auto leaf = spot._leaf;
+  auto idx  = spot._idx;
+  // Routing is unaffected if the new minimum stays within the minimums already in the leaf.
+  if ((idx > 0 || !(min < leaf->_min[0])) && (idx + 1 < leaf->_count || !(leaf->_min[idx] < min))) {
+    leaf->_min[idx] = min;
+  } else {
+    METRIC max{leaf->_max[idx]};
+    PAYLOAD payload{std::move(leaf->_payload[idx])};
+    this->remove(leaf->_min[idx]);
+    this->insert(min, max, payload);
+  }
+}
+
+template <typename METRIC, typename PAYLOAD>
+void
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::place(METRIC const &min, METRIC const &max, PAYLOAD const &payload) {
+  auto pred = this->lower_bound(min);
+  auto succ = pred ? this->next(pred) : this->head();
+  // Increments are safe because the existence of the neighbor means the value isn't at the limit.
+  bool pred_p = pred && ++metric_type{pred.max()} == min && pred.payload() == payload;
+  bool succ_p = succ && succ.min() == ++metric_type{max} && succ.payload() == payload;
+
+  if (pred_p) {
+    if (succ_p) {
+      pred.max_ref() = succ.max(); // Routing is by minimum, so this is safe before removing @a succ.
+      this->remove(succ.min());
+    } else {
+      pred.max_ref() = max;
+    }
+  } else if (succ_p) {
+    this->assign_min(succ, min);
+  } else {
+    this->insert(min, max, payload);
+  }
+}
+
+template <typename METRIC, typename PAYLOAD>
+auto
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::erase(range_type const &range) -> self_type & {
+  while (true) {
+    auto spot = this->lower_bound(range.min());
+    if (!spot) {
+      spot = this->head();
+    } else if (spot.max() < range.min()) {
+      spot = this->next(spot);
+    }
+    if (!spot || range.max() < spot.min()) {
+      break; // cleared the target range, done.
+    }
+
+    if (spot.min() < range.min()) {
+      if (range.max() < spot.max()) { // @a spot covers @a range, must split.
+        METRIC max{spot.max()};
+        PAYLOAD payload{spot.payload()};
+        spot.max_ref() = --metric_type{range.min()};
+        this->insert(++metric_type{range.max()}, max, payload);
+        break;
+      }
+      spot.max_ref() = --metric_type{range.min()}; // stub on the left, clip to that.
+    } else if (range.max() < spot.max()) { // stub on the right, clip and done.
+      this->assign_min(spot, ++metric_type{range.max()});
+      break;
+    } else { // covered, remove.
+      this->remove(spot.min());
+    }
+  }
+  return *this;
+}
+
+template <typename METRIC, typename PAYLOAD>
+auto
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::mark(range_type const &range, PAYLOAD const &payload) -> self_type & {
+  this->erase(range);
+  this->place(range.min(), range.max(), payload);
+  return *this;
+}
+
+template <typename METRIC, typename PAYLOAD>
+auto
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::fill(range_type const &range, PAYLOAD const &payload) -> self_type & {
+  auto min = range.min(); // start of the unprocessed part of @a range.
+  while (true) {
+    auto spot = this->lower_bound(min);
+    if (spot && !(spot.max() < min)) { // @a min is already covered, skip past.
+      if (!(spot.max() < range.max())) {
+        break;
+      }
+      min = ++metric_type{spot.max()};
+      continue;
+    }
+
+    auto succ = spot ? this->next(spot) : this->head();
+    if (!succ || range.max() < succ.min()) { // the rest of @a range is a gap.
+      this->place(min, range.max(), payload);
+      break;
+    }
+    // Fill the gap up to @a succ, then continue after it.
+    METRIC succ_max{succ.max()};
+    this->place(min, --metric_type{succ.min()}, payload);
+    if (!(succ_max < range.max())) {
+      break;
+    }
+    min = ++succ_max;
+  }
+  return *this;
+}
+
+template <typename METRIC, typename PAYLOAD>
+template <typename F, typename U>
+auto
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceBTree>::blend(range_type const &range, U const &color, F &&blender) -> self_type & {
+  // Do a base check for the color to use on unmapped values. If self blending on @a color
+  // is @c false, then do not color currently unmapped values.
+  PAYLOAD plain_color{};                            // color to paint uncolored metrics.
+  bool plain_color_p = blender(plain_color, color); // start with default and blend in @a color.
+
+  auto min = range.min(); // start of the unprocessed part of @a range.
+  while (true) {
+    auto spot = this->lower_bound(min);
+    METRIC max; // end of the segment processed in this loop.
+    if (spot && !(spot.max() < min)) { // overlap - blend in to the existing payload.
+      max = spot.max() < range.max() ? spot.max() : range.max();
+      PAYLOAD payload{spot.payload()};
+      bool fill_p = blender(payload, color);
+      if (!fill_p || !(payload == spot.payload())) {
+        this->erase({min, max});
+        if (fill_p) {
+          this->place(min, max, payload);
+        }
+      }
+    } else { // gap - use the plain color.
+      auto succ = spot ? this->next(spot) : this->head();
+      max       = (!succ || range.max() < succ.min()) ? range.max() : --metric_type{succ.min()};
+      if (plain_color_p) {
+        this->place(min, max, plain_color);
+      }
+    }
+    if (!(max < range.max())) {
+      break;
+    }
+    min = ++max;
+  }
+  return *this;
+}
+
+}} // namespace swoc::SWOC_VERSION_NS
@@ -10,6 +10,7 @@
 #pragma once
 #include <limits>
 #include <functional>
+#include <atomic>
 
 #include "swoc/swoc_version.h"
 #include "swoc/swoc_meta.h"
@@ -584,10 +585,18 @@ operator>=(DiscreteRange<T> const &lhs, DiscreteRange<T> const &rhs) {
   return lhs.is_superset_of(rhs);
 }
 
+/** Storage selector for @c DiscreteSpace - a red/black tree of nodes threaded on an ordered list.
+ *
+ * This is the default. Each range is a separate node and node pointers are stable across
+ * modifications of the space.
+ */
+struct DiscreteSpaceRBTree {};
+
 /** A space for a discrete @c METRIC.
  *
  * @tparam METRIC Value type for the space.
  * @tparam PAYLOAD Data stored with values in the space.
+ * @tparam STORAGE Storage selector for the ranges.
  *
  * This is a range based mapping of all values in @c METRIC (the "space") to @c PAYLOAD.
  *
@@ -595,8 +604,14 @@ operator>=(DiscreteRange<T> const &lhs, DiscreteRange<T> const &rhs) {
  *
  * @c METRIC must be
  * - discrete and finite valued type with increment and decrement operations.
+ *
+ * @a STORAGE is @c DiscreteSpaceRBTree by default. @c DiscreteSpaceBTree (in "swoc/DiscreteBTree.h")
+ * selects a B+ tree with packed leaves.
  */
-template <typename METRIC, typename PAYLOAD> class DiscreteSpace {
+template <typename METRIC, typename PAYLOAD, typename STORAGE = DiscreteSpaceRBTree> class DiscreteSpace;
+
+/// Red/black tree based @c DiscreteSpace.
+template <typename METRIC, typename PAYLOAD> class DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree> {
   using self_type = DiscreteSpace;
 
 protected:
@@ -613,6 +628,7 @@ protected:
     range_type _range;  ///< Range covered by this node.
     range_type _hull;   ///< Range covered by subtree rooted at this node.
     PAYLOAD _payload{}; ///< Default constructor, should zero init if @c PAYLOAD is a pointer.
+    std::atomic<uint64_t> _hits{0}; ///< Number of lookups that found this node, if counting.
 
   public:
     /// Linkage for @c IntrusiveDList.
@@ -629,6 +645,12 @@ protected:
     /// @return The payload in the node.
     PAYLOAD &payload();
 
+    /// @return The number of lookups that found this node while hit counting was enabled.
+    uint64_t
+    hits() const {
+      return _hits.load(std::memory_order_relaxed);
+    }
+
     /** Set the @a range of a node.
      *
      * @param range Range to use.
@@ -691,6 +713,7 @@ protected:
   IntrusiveDList<typename Node::Linkage> _list; ///< In order list of nodes.
   swoc::MemArena _arena{4000};                  ///< Memory Storage.
   swoc::FixedArena<Node> _fa{_arena};           ///< Node allocator and free list.
+  std::atomic<bool> _hit_count_p{false};        ///< Count successful lookups per node.
 
   // Utility methods to avoid having casts scattered all over.
   Node *
@@ -780,6 +803,38 @@ public:
   /// @return The number of distinct ranges.
   size_t count() const;
 
+  /** Enable or disable hit counting.
+   *
+   * @param flag @c true to enable, @c false to disable.
+   * @return @a this
+   *
+   * If enabled, every successful @c find increments a relaxed atomic counter in the node found.
+   * Counts are attached to nodes, not values, and so modifying the space may leave counts on ranges
+   * that have changed. Use @c reset_hits after modifications if that matters.
+   *
+   * The flag is atomic, so this can be called while other threads are calling @c find. Lookups that
+   * overlap the change may or may not be counted.
+   */
+  self_type &
+  set_hit_counting(bool flag) {
+    _hit_count_p.store(flag, std::memory_order_relaxed);
+    return *this;
+  }
+
+  /// @return @c true if hit counting is enabled.
+  bool
+  is_hit_counting() const {
+    return _hit_count_p.load(std::memory_order_relaxed);
+  }
+
+  /// Set the hit count of every range to zero.
+  void
+  reset_hits() {
+    for (auto &node : _list) {
+      node._hits.store(0, std::memory_order_relaxed);
+    }
+  }
+
   iterator
   begin() {
     return _list.begin();
@@ -844,27 +899,27 @@ protected:
 
 template <typename METRIC, typename PAYLOAD>
 PAYLOAD &
-DiscreteSpace<METRIC, PAYLOAD>::Node::payload() {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::Node::payload() {
   return _payload;
 }
 
 template <typename METRIC, typename PAYLOAD>
 auto
-DiscreteSpace<METRIC, PAYLOAD>::Node::assign(DiscreteSpace::range_type const &range) -> self_type & {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::Node::assign(DiscreteSpace::range_type const &range) -> self_type & {
   _range = range;
   return *this;
 }
 
 template <typename METRIC, typename PAYLOAD>
 auto
-DiscreteSpace<METRIC, PAYLOAD>::Node::assign(PAYLOAD const &payload) -> self_type & {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::Node::assign(PAYLOAD const &payload) -> self_type & {
   _payload = payload;
   return *this;
 }
 
 template <typename METRIC, typename PAYLOAD>
 void
-DiscreteSpace<METRIC, PAYLOAD>::Node::structure_fixup() {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::Node::structure_fixup() {
   // Invariant: The hulls of all children are correct.
   if (_left && _right) {
     // If both children, local range must be inside the hull of the children and irrelevant.
@@ -880,7 +935,7 @@ DiscreteSpace<METRIC, PAYLOAD>::Node::structure_fixup() {
 
 // ---
 
-template <typename METRIC, typename PAYLOAD> DiscreteSpace<METRIC, PAYLOAD>::~DiscreteSpace() {
+template <typename METRIC, typename PAYLOAD> DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::~DiscreteSpace() {
   // Destruct all the payloads - the nodes themselves are in the arena and disappear with it.
   for (auto &node : _list) {
     std::destroy_at(&node.payload());
@@ -889,19 +944,19 @@ template <typename METRIC, typename PAYLOAD> DiscreteSpace<METRIC, PAYLOAD>::~Di
 
 template <typename METRIC, typename PAYLOAD>
 size_t
-DiscreteSpace<METRIC, PAYLOAD>::count() const {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::count() const {
   return _list.count();
 }
 
 template <typename METRIC, typename PAYLOAD>
 auto
-DiscreteSpace<METRIC, PAYLOAD>::head() -> Node * {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::head() -> Node * {
   return static_cast<Node *>(_list.head());
 }
 
 template <typename METRIC, typename PAYLOAD>
 auto
-DiscreteSpace<METRIC, PAYLOAD>::find(METRIC const &metric) -> iterator {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::find(METRIC const &metric) -> iterator {
   auto n = _root; // current node to test.
   while (n) {
     if (metric < n->min()) {
@@ -917,6 +972,9 @@ DiscreteSpace<METRIC, PAYLOAD>::find(METRIC const &metric) -> iterator {
         return this->end();
       }
     } else {
+      if (_hit_count_p.load(std::memory_order_relaxed)) {
+        n->_hits.fetch_add(1, std::memory_order_relaxed);
+      }
       return _list.iterator_for(n);
     }
   }
@@ -925,7 +983,7 @@ DiscreteSpace<METRIC, PAYLOAD>::find(METRIC const &metric) -> iterator {
 
 template <typename METRIC, typename PAYLOAD>
 auto
-DiscreteSpace<METRIC, PAYLOAD>::lower_bound(METRIC const &target) -> Node * {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::lower_bound(METRIC const &target) -> Node * {
   Node *n    = _root;   // current node to test.
   Node *zret = nullptr; // best node so far.
 
@@ -951,7 +1009,7 @@ DiscreteSpace<METRIC, PAYLOAD>::lower_bound(METRIC const &target) -> Node * {
 
 template <typename METRIC, typename PAYLOAD>
 void
-DiscreteSpace<METRIC, PAYLOAD>::prepend(DiscreteSpace::Node *node) {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::prepend(DiscreteSpace::Node *node) {
   if (!_root) {
     _root = node;
   } else {
@@ -962,7 +1020,7 @@ DiscreteSpace<METRIC, PAYLOAD>::prepend(DiscreteSpace::Node *node) {
 
 template <typename METRIC, typename PAYLOAD>
 void
-DiscreteSpace<METRIC, PAYLOAD>::append(DiscreteSpace::Node *node) {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::append(DiscreteSpace::Node *node) {
   if (!_root) {
     _root = node;
   } else {
@@ -974,7 +1032,7 @@ DiscreteSpace<METRIC, PAYLOAD>::append(DiscreteSpace::Node *node) {
 
 template <typename METRIC, typename PAYLOAD>
 void
-DiscreteSpace<METRIC, PAYLOAD>::insert_before(DiscreteSpace::Node *spot, DiscreteSpace::Node *node) {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::insert_before(DiscreteSpace::Node *spot, DiscreteSpace::Node *node) {
   if (left(spot) == nullptr) {
     spot->set_child(node, Direction::LEFT);
   } else {
@@ -990,7 +1048,7 @@ DiscreteSpace<METRIC, PAYLOAD>::insert_before(DiscreteSpace::Node *spot, Discret
 
 template <typename METRIC, typename PAYLOAD>
 void
-DiscreteSpace<METRIC, PAYLOAD>::insert_after(DiscreteSpace::Node *spot, DiscreteSpace::Node *node) {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::insert_after(DiscreteSpace::Node *spot, DiscreteSpace::Node *node) {
   if (right(spot) == nullptr) {
     spot->set_child(node, Direction::RIGHT);
   } else {
@@ -1005,8 +1063,8 @@ DiscreteSpace<METRIC, PAYLOAD>::insert_after(DiscreteSpace::Node *spot, Discrete
 }
 
 template <typename METRIC, typename PAYLOAD>
-DiscreteSpace<METRIC, PAYLOAD> &
-DiscreteSpace<METRIC, PAYLOAD>::erase(DiscreteSpace::range_type const &range) {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree> &
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::erase(DiscreteSpace::range_type const &range) {
   Node *n = this->lower_bound(range.min()); // current node.
   while (n) {
     auto nn = next(n);            // cache in case @a n disappears.
@@ -1036,8 +1094,8 @@ DiscreteSpace<METRIC, PAYLOAD>::erase(DiscreteSpace::range_type const &range) {
 }
 
 template <typename METRIC, typename PAYLOAD>
-DiscreteSpace<METRIC, PAYLOAD> &
-DiscreteSpace<METRIC, PAYLOAD>::mark(DiscreteSpace::range_type const &range, PAYLOAD const &payload) {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree> &
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::mark(DiscreteSpace::range_type const &range, PAYLOAD const &payload) {
   Node *n = this->lower_bound(range.min()); // current node.
   Node *x = nullptr;                        // New node, gets set if we re-use an existing one.
   Node *y = nullptr;                        // Temporary for removing and advancing.
@@ -1157,8 +1215,8 @@ DiscreteSpace<METRIC, PAYLOAD>::mark(DiscreteSpace::range_type const &range, PAY
 }
 
 template <typename METRIC, typename PAYLOAD>
-DiscreteSpace<METRIC, PAYLOAD> &
-DiscreteSpace<METRIC, PAYLOAD>::fill(DiscreteSpace::range_type const &range, PAYLOAD const &payload) {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree> &
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::fill(DiscreteSpace::range_type const &range, PAYLOAD const &payload) {
   // Rightmost node of interest with n->min() <= min.
   Node *n = this->lower_bound(range.min());
   Node *x = nullptr; // New node (if any).
@@ -1277,7 +1335,7 @@ DiscreteSpace<METRIC, PAYLOAD>::fill(DiscreteSpace::range_type const &range, PAY
 template <typename METRIC, typename PAYLOAD>
 template <typename F, typename U>
 auto
-DiscreteSpace<METRIC, PAYLOAD>::blend(DiscreteSpace::range_type const &range, U const &color, F &&blender) -> self_type & {
+DiscreteSpace<METRIC, PAYLOAD, DiscreteSpaceRBTree>::blend(DiscreteSpace::range_type const &range, U const &color, F &&blender) -> self_type & {
   // Do a base check for the color to use on unmapped values. If self blending on @a color
   // is @c false, then do not color currently unmapped values.
   PAYLOAD plain_color{};                            // color to paint uncolored metrics.
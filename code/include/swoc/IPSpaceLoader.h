@@ -0,0 +1,263 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+
+    Load an @c IPSpace from delimited text.
+*/
+
+#pragma once
+
+#include <functional>
+
+#include "swoc/swoc_version.h"
+#include "swoc/TextView.h"
+#include "swoc/Errata.h"
+#include "swoc/swoc_ip.h"
+#include "swoc/swoc_file.h"
+#include "swoc/bwf_std.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+
+/** Load an @c IPSpace from delimited text, such as a CSV file.
+ *
+ * @tparam PAYLOAD The payload type of the space.
+ *
+ * Each line of the input is a set of fields separated by a delimiter. The first field is an IP
+ * address range in any format accepted by @c IPRange::load - a range, a singleton address, or a
+ * network. The remaining text on the line is passed to a parser which produces the payload for
+ * that range. Empty lines and comment lines are skipped.
+ *
+ * Files are read a block at a time and lines and fields are passed as views in to the read buffer,
+ * so large files are loaded with bounded memory and no per line allocation. The views are valid
+ * only for the duration of the call to the parser - any text retained by the payload must be
+ * copied.
+ *
+ * Errors are accumulated in the returned @c Errata with the line number of the error. Loading
+ * continues after an error until the error limit is reached.
+ */
+template <typename PAYLOAD> class IPSpaceLoader {
+  using self_type = IPSpaceLoader; ///< Self reference type.
+public:
+  using space_type = IPSpace<PAYLOAD>; ///< Space to load.
+
+  /** Payload parser.
+   *
+   * The argument is the text after the range field and its delimiter, with leading and trailing
+   * whitespace removed. The return value is the payload for the range, or errors if the text is
+   * not valid.
+   */
+  using parser_type = std::function<Rv<PAYLOAD>(TextView fields)>;
+
+  /// How payloads are applied to the space.
+  enum class Mode {
+    MARK, ///< Overwrite existing payloads - @c IPSpace::mark
+    FILL, ///< Only fill empty addresses - @c IPSpace::fill
+  };
+
+  /** Construct a loader.
+   *
+   * @param space Destination space.
+   * @param parser Payload parser.
+   */
+  IPSpaceLoader(space_type &space, parser_type &&parser);
+
+  /** Set the field delimiter.
+   *
+   * @param c Delimiter character.
+   * @return @a this
+   *
+   * The default is a comma.
+   */
+  self_type &delimiter(char c);
+
+  /** Set the comment character.
+   *
+   * @param c Comment character.
+   * @return @a this
+   *
+   * Lines that have this character as the first non-whitespace character are skipped. The
+   * default is '#'.
+   */
+  self_type &comment(char c);
+
+  /** Set the payload application mode.
+   *
+   * @param mode Application mode.
+   * @return @a this
+   */
+  self_type &mode(Mode mode);
+
+  /** Set the maximum number of errors.
+   *
+   * @param n Maximum number of errors, 0 for no limit.
+   * @return @a this
+   *
+   * If this many errors are reported, loading stops. The default is 100.
+   */
+  self_type &error_limit(size_t n);
+
+  /** Load the file at @a path.
+   *
+   * @param path Path to the file.
+   * @param block_size Size of the read buffer.
+   * @return Errors, if any.
+   */
+  Errata load(file::path const &path, size_t block_size = file::line_reader::DEFAULT_BLOCK_SIZE);
+
+  /** Load from @a content.
+   *
+   * @param content Text to load.
+   * @return Errors, if any.
+   */
+  Errata load(TextView content);
+
+  /// @return The number of lines processed by the last load.
+  size_t line_count() const;
+
+  /// @return The number of ranges applied to the space by the last load.
+  size_t range_count() const;
+
+protected:
+  space_type &_space;         ///< Destination.
+  parser_type _parser;        ///< Payload parser.
+  char _delimiter     = ',';  ///< Field delimiter.
+  char _comment       = '#';  ///< Comment character.
+  Mode _mode          = Mode::MARK; ///< Payload application.
+  size_t _error_limit = 100;  ///< Maximum number of errors.
+
+  size_t _line_count  = 0; ///< # of lines processed.
+  size_t _range_count = 0; ///< # of ranges applied.
+  size_t _error_count = 0; ///< # of errors.
+
+  /// Reset the load counters.
+  void reset();
+
+  /** Process a single line.
+   *
+   * @param errata Error accumulator.
+   * @param line Text of the line.
+   * @param line_no Line number.
+   * @return @c true to continue loading, @c false if the error limit has been reached.
+   */
+  bool process(Errata &errata, TextView line, size_t line_no);
+};
+
+// --- Implementation ---
+
+template <typename PAYLOAD>
+IPSpaceLoader<PAYLOAD>::IPSpaceLoader(space_type &space, parser_type &&parser) : _space(space), _parser(std::move(parser)) {}
+
+template <typename PAYLOAD>
+auto
+IPSpaceLoader<PAYLOAD>::delimiter(char c) -> self_type & {
+  _delimiter = c;
+  return *this;
+}
+
+template <typename PAYLOAD>
+auto
+IPSpaceLoader<PAYLOAD>::comment(char c) -> self_type & {
+  _comment = c;
+  return *this;
+}
+
+template <typename PAYLOAD>
+auto
+IPSpaceLoader<PAYLOAD>::mode(Mode mode) -> self_type & {
+  _mode = mode;
+  return *this;
+}
+
+template <typename PAYLOAD>
+auto
+IPSpaceLoader<PAYLOAD>::error_limit(size_t n) -> self_type & {
+  _error_limit = n;
+  return *this;
+}
+
+template <typename PAYLOAD>
+size_t
+IPSpaceLoader<PAYLOAD>::line_count() const {
+  return _line_count;
+}
+
+template <typename PAYLOAD>
+size_t
+IPSpaceLoader<PAYLOAD>::range_count() const {
+  return _range_count;
+}
+
+template <typename PAYLOAD>
+void
+IPSpaceLoader<PAYLOAD>::reset() {
+  _line_count = _range_count = _error_count = 0;
+}
+
+template <typename PAYLOAD>
+bool
+IPSpaceLoader<PAYLOAD>::process(Errata &errata, TextView line, size_t line_no) {
+  ++_line_count;
+  line.trim_if(&isspace);
+  if (line.empty() || _comment == *line) {
+    return true;
+  }
+
+  auto token = line.take_prefix_at(_delimiter).rtrim_if(&isspace);
+  IPRange range;
+  if (!range.load(token)) {
+    errata.note(R"(Invalid range "{}" at line {}.)", token, line_no);
+    ++_error_count;
+  } else if (auto rv = _parser(line.ltrim_if(&isspace)); !rv.is_ok()) {
+    errata.note(std::move(rv.errata()));
+    errata.note("Invalid payload at line {}.", line_no);
+    ++_error_count;
+  } else {
+    if (Mode::FILL == _mode) {
+      _space.fill(range, rv.result());
+    } else {
+      _space.mark(range, rv.result());
+    }
+    ++_range_count;
+  }
+
+  if (_error_limit && _error_count >= _error_limit) {
+    errata.note("Error limit of {} reached at line {}, loading stopped.", _error_limit, line_no);
+    return false;
+  }
+  return true;
+}
+
+template <typename PAYLOAD>
+Errata
+IPSpaceLoader<PAYLOAD>::load(TextView content) {
+  Errata zret;
+  this->reset();
+  for (size_t line_no = 1; content; ++line_no) {
+    if (!this->process(zret, content.take_prefix_at('\n'), line_no)) {
+      break;
+    }
+  }
+  return zret;
+}
+
+template <typename PAYLOAD>
+Errata
+IPSpaceLoader<PAYLOAD>::load(file::path const &path, size_t block_size) {
+  Errata zret;
+  this->reset();
+  file::line_reader reader{block_size};
+  if (auto ec = reader.open(path); ec) {
+    return Errata(ec, R"(Unable to open "{}" - {}.)", path, ec);
+  }
+  for (TextView line; reader.next(line);) {
+    if (!this->process(zret, line, reader.line_no())) {
+      break;
+    }
+  }
+  if (auto ec = reader.error(); ec) {
+    zret.assign(ec).note(R"(Failed to read "{}" after line {} - {}.)", path, reader.line_no(), ec);
+  }
+  return zret;
+}
+
+}} // namespace swoc::SWOC_VERSION_NS
@@ -15,6 +15,7 @@
 /// Clang doesn't like just declaring the tag struct we need so we have to include the file.
 #include <iterator>
 #include <type_traits>
+#include <functional>
 
 #include "swoc/swoc_version.h"
 
@@ -299,6 +300,64 @@ public:
   /// @return This container.
   self_type &clear();
 
+  /** Move all elements of @a that in to this list.
+   *
+   * @param target Location in this list.
+   * @param that Source list.
+   * @return @a this
+   *
+   * The elements are inserted before @a target, in the same order, and @a that is left empty. This
+   * is constant time.
+   */
+  self_type &splice(iterator const &target, self_type &that);
+
+  /** Move a range of elements from @a that in to this list.
+   *
+   * @param target Location in this list.
+   * @param that Source list.
+   * @param first First element to move.
+   * @param last Element after the last element to move.
+   * @return @a this
+   *
+   * The elements [first, last) are moved to before @a target, in the same order. @a that can be
+   * this list, in which case @a target must not be in the range. Only the end points are relinked,
+   * but the range is walked once to update the element counts.
+   */
+  self_type &splice(iterator const &target, self_type &that, iterator const &first, iterator const &last);
+
+  /** Merge a sorted list in to this sorted list.
+   *
+   * @tparam C Comparison functor, compatible with <tt>bool (value_type const&, value_type const&)</tt>.
+   * @param that Source list.
+   * @param cmp Less than comparison.
+   * @return @a this
+   *
+   * Both lists must be sorted by @a cmp. The merge is stable - for equal elements, those from this
+   * list come first. @a that is left empty.
+   */
+  template <typename C = std::less<>> self_type &merge(self_type &that, C &&cmp = C{});
+
+  /** Sort the list.
+   *
+   * @tparam C Comparison functor, compatible with <tt>bool (value_type const&, value_type const&)</tt>.
+   * @param cmp Less than comparison.
+   * @return @a this
+   *
+   * This is a stable merge sort done entirely by relinking the elements, no memory is allocated.
+   */
+  template <typename C = std::less<>> self_type &sort(C &&cmp = C{});
+
+  /** Partition the list.
+   *
+   * @tparam P Predicate functor, compatible with <tt>bool (value_type const&)</tt>.
+   * @param pred Predicate.
+   * @return An iterator to the first element for which @a pred is @c false.
+   *
+   * The elements for which @a pred is @c true are moved before the elements for which it is not.
+   * The relative order of the elements in each group is preserved.
+   */
+  template <typename P> iterator partition(P &&pred);
+
   /// @return Number of elements in the list.
   size_t count() const;
 
@@ -345,6 +404,18 @@ protected:
   value_type *_head{nullptr}; ///< First element in list.
   value_type *_tail{nullptr}; ///< Last element in list.
   size_t _count{0};           ///< Number of elements in list.
+
+  /** Merge two chains.
+   *
+   * A chain is a sequence linked by the next pointers and terminated by @c nullptr. The previous
+   * pointers are not updated.
+   *
+   * @return The first element of the merged chain.
+   */
+  template <typename C> static value_type *merge_chains(value_type *a, value_type *b, C &cmp);
+
+  /// Set this list to the chain starting with @a head, updating the previous pointers and the tail.
+  void adopt_chain(value_type *head);
 };
 
 /** Utility class to provide intrusive links.
@@ -877,6 +948,147 @@ IntrusiveDList<L>::clear() -> self_type & {
   return *this;
 }
 
+template <typename L>
+auto
+IntrusiveDList<L>::splice(iterator const &target, self_type &that) -> self_type & {
+  return this->splice(target, that, that.begin(), that.end());
+}
+
+template <typename L>
+auto
+IntrusiveDList<L>::splice(iterator const &target, self_type &that, iterator const &first, iterator const &last)
+  -> self_type & {
+  if (first == last) {
+    return *this;
+  }
+  value_type *f = first._v;
+  value_type *l = last._v ? L::prev_ptr(last._v) : that._tail;
+
+  size_t n = that._count;
+  if (&that == this) {
+    n = 0; // count doesn't change.
+  } else if (f != that._head || l != that._tail) { // not the entire list, must count.
+    n = 1;
+    for (value_type *v = f; v != l; v = L::next_ptr(v)) {
+      ++n;
+    }
+  }
+
+  // Take the range out of @a that.
+  value_type *before = L::prev_ptr(f);
+  value_type *after  = L::next_ptr(l);
+  (before ? L::next_ptr(before) : that._head) = after;
+  (after ? L::prev_ptr(after) : that._tail)   = before;
+  that._count -= n;
+
+  // Put the range in before @a target.
+  value_type *t  = target._v;
+  before         = t ? L::prev_ptr(t) : _tail;
+  L::prev_ptr(f) = before;
+  L::next_ptr(l) = t;
+  (before ? L::next_ptr(before) : _head) = f;
+  (t ? L::prev_ptr(t) : _tail)           = l;
+  _count += n;
+  return *this;
+}
+
+template <typename L>
+template <typename C>
+auto
+IntrusiveDList<L>::merge_chains(value_type *a, value_type *b, C &cmp) -> value_type * {
+  value_type *zret  = nullptr;
+  value_type **spot = &zret; // Where to put the next element.
+  while (a && b) {
+    if (cmp(*b, *a)) { // take from @a a unless @a b is strictly less, for stability.
+      *spot = b;
+      spot  = &L::next_ptr(b);
+      b     = *spot;
+    } else {
+      *spot = a;
+      spot  = &L::next_ptr(a);
+      a     = *spot;
+    }
+  }
+  *spot = a ? a : b;
+  return zret;
+}
+
+template <typename L>
+void
+IntrusiveDList<L>::adopt_chain(value_type *head) {
+  value_type *prev = nullptr;
+  _head            = head;
+  for (value_type *v = head; v; v = L::next_ptr(v)) {
+    L::prev_ptr(v) = prev;
+    prev           = v;
+  }
+  _tail = prev;
+}
+
+template <typename L>
+template <typename C>
+auto
+IntrusiveDList<L>::merge(self_type &that, C &&cmp) -> self_type & {
+  if (this != &that && !that.empty()) {
+    auto n = _count + that._count;
+    this->adopt_chain(merge_chains(_head, that._head, cmp));
+    _count = n;
+    that.clear();
+  }
+  return *this;
+}
+
+template <typename L>
+template <typename C>
+auto
+IntrusiveDList<L>::sort(C &&cmp) -> self_type & {
+  // Bottom up merge sort. Slot @a i holds a sorted chain of 2^i elements or is empty, and slots
+  // with larger indices hold elements from earlier in the list.
+  value_type *slots[64] = {};
+  size_t n_slots        = 0;
+
+  for (value_type *v = _head, *next; v; v = next) {
+    next              = L::next_ptr(v);
+    L::next_ptr(v)    = nullptr;
+    value_type *carry = v;
+    size_t idx        = 0;
+    for (; slots[idx]; ++idx) {
+      carry      = merge_chains(slots[idx], carry, cmp);
+      slots[idx] = nullptr;
+    }
+    slots[idx] = carry;
+    if (idx >= n_slots) {
+      n_slots = idx + 1;
+    }
+  }
+
+  value_type *chain = nullptr;
+  for (size_t idx = 0; idx < n_slots; ++idx) {
+    if (slots[idx]) {
+      chain = merge_chains(slots[idx], chain, cmp);
+    }
+  }
+  this->adopt_chain(chain);
+  return *this;
+}
+
+template <typename L>
+template <typename P>
+auto
+IntrusiveDList<L>::partition(P &&pred) -> iterator {
+  self_type tail_list;
+  for (value_type *v = _head, *next; v; v = next) {
+    next = L::next_ptr(v);
+    if (!pred(*v)) {
+      this->erase(v);
+      tail_list.append(v);
+    }
+  }
+  value_type *zret = tail_list._head;
+  this->splice(this->end(), tail_list);
+  return this->iterator_for(zret);
+}
+
 namespace detail {
 // Make @c apply more convenient by allowing the function to take a reference type or pointer type
 // to the container elements. The pointer type is the base, plus a shim to convert from a reference
@@ -0,0 +1,535 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Apache Software Foundation 2019
+/** @file
+
+  Intrusive hash map with an open addressed index.
+
+  This is an alternative to @c IntrusiveHashMap for tables that are mostly used for lookup.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "swoc/swoc_version.h"
+#include "swoc/IntrusiveDList.h"
+#include "swoc/IntrusiveHashMap.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+/** Intrusive hash map with an open addressed index.
+ *
+ * @tparam H Descriptor, the same as for @c IntrusiveHashMap including the optional @c hash_cache.
+ *
+ * The elements are kept in an intrusive list, as for @c IntrusiveHashMap, which is used for
+ * iteration. The index is a flat array of element pointers with a parallel array of control bytes,
+ * one per slot. A control byte is either empty, deleted, or 7 bits of the hash value of the element
+ * in the slot. Slots are grouped in to blocks of @c GROUP_WIDTH and a lookup checks an entire
+ * group at once by comparing the control bytes to the hash bits, with SSE2 if available. Only
+ * elements with matching hash bits are compared with @c H::equal. Therefore a lookup usually touches
+ * one group of control bytes and one element, instead of every element in a chain.
+ *
+ * Duplicate keys are allowed. Elements with equal keys are adjacent in iteration order, in the order
+ * they were inserted, and @c find returns the first of them.
+ *
+ * Compared to @c IntrusiveHashMap, insert and erase are slower and memory use is higher, in return
+ * for faster lookup, particularly for keys that are not in the map.
+ */
+template <typename H> class IntrusiveFlatHashMap {
+  using self_type = IntrusiveFlatHashMap; ///< Self reference type.
+  using shadow    = IntrusiveHashMap<H>;  ///< For shared type deduction.
+
+public:
+  /// Type of elements in the map.
+  using value_type = typename shadow::value_type;
+  /// Key type for the elements.
+  using key_type = typename shadow::key_type;
+  /// The numeric hash ID computed from a key.
+  using hash_id = typename shadow::hash_id;
+
+  using iterator       = typename IntrusiveDList<H>::iterator;
+  using const_iterator = typename IntrusiveDList<H>::const_iterator;
+
+  /// A range of elements, [first, last).
+  using range = typename shadow::range;
+  /// A range of constant elements, [first, last).
+  using const_range = typename shadow::const_range;
+
+  /// Number of slots checked at once.
+  static constexpr size_t GROUP_WIDTH = 16;
+
+  /** Construct with space for @a n elements.
+   *
+   * @param n Number of elements.
+   *
+   * No memory is allocated if @a n is zero.
+   */
+  explicit IntrusiveFlatHashMap(size_t n = 0);
+
+  /// Move constructor.
+  IntrusiveFlatHashMap(self_type &&that) = default;
+
+  /** Remove all values from the map.
+   *
+   * @return @a this
+   *
+   * The values are not touched, therefore it is safe to destroy them first and then @c clear
+   * the map. The index keeps its capacity.
+   */
+  self_type &clear();
+
+  iterator begin();             ///< First element.
+  const_iterator begin() const; ///< First element.
+  iterator end();               ///< Past last element.
+  const_iterator end() const;   ///< Past last element.
+
+  /** Insert a value in to the map.
+   *
+   * @param v Value to insert.
+   *
+   * The @a value must @b NOT already be in a map of this type.
+   */
+  void insert(value_type *v);
+
+  /** Find an element with a key equal to @a key.
+   *
+   * @return The first element with a matching key, or the end iterator if not found.
+   */
+  iterator find(key_type key);
+  const_iterator find(key_type key) const;
+
+  /** Get an iterator for an existing value @a v.
+   *
+   * @return An iterator that references @a v, or the end iterator if @a v is not in the map.
+   */
+  iterator find(value_type *v);
+  const_iterator find(value_type const *v) const;
+
+  /** Find the range of elements with keys equal to @a key.
+   *
+   * @return A iterator pair of [first, last) items with equal keys.
+   */
+  range equal_range(key_type key);
+  const_range equal_range(key_type key) const;
+
+  /// @return An iterator for @a v, which must be in the map.
+  iterator iterator_for(value_type *v);
+  const_iterator iterator_for(value_type const *v) const;
+
+  /** Remove the value at @a loc from the map.
+   *
+   * @return An iterator to the next value past @a loc.
+   */
+  iterator erase(iterator const &loc);
+
+  /** Remove @a value from the map.
+   *
+   * @return @c true if @a value was in the map and removed, @c false if it was not in the map.
+   */
+  bool erase(value_type *value);
+
+  /** Apply @a f to every element in the map.
+   *
+   * @tparam F A functional object of the form <tt>void F(value_type&)</tt> or <tt>void F(value_type *)</tt>
+   * @param f The function to apply.
+   * @return @a this
+   *
+   * As with @c IntrusiveHashMap::apply this is safe to use to destroy the elements.
+   */
+  template <typename F> self_type &apply(F &&f);
+
+  /** Make sure there is space for at least @a n elements.
+   *
+   * @param n Number of elements.
+   * @return @a this
+   */
+  self_type &reserve(size_t n);
+
+  /// Number of elements in the map.
+  size_t count() const;
+
+  /// Number of slots in the index.
+  size_t capacity() const;
+
+protected:
+  using List = IntrusiveDList<H>;
+
+  /// Control byte for an empty slot.
+  static constexpr uint8_t EMPTY = 0x80;
+  /// Control byte for a slot with a deleted element.
+  static constexpr uint8_t DELETED = 0xFE;
+  /// Not found marker for slot indices.
+  static constexpr size_t npos = ~size_t(0);
+
+  List _list;                       ///< Elements in the map.
+  std::vector<uint8_t> _ctrl;       ///< Control bytes, one per slot.
+  std::vector<value_type *> _slots; ///< Elements in the index.
+  size_t _group_mask = 0;           ///< Number of groups minus one.
+  size_t _deleted    = 0;           ///< Number of deleted slots.
+
+  /// Hash value of @a v, from the cache if available.
+  static hash_id hash_value(value_type *v);
+  /// Mix the hash value so that weak hashes spread over the groups and control bytes.
+  static uint64_t mix(hash_id h);
+
+  /// @return A bit mask of the slots in the group at @a ctrl with control byte @a c.
+  static unsigned match(uint8_t const *ctrl, uint8_t c);
+  /// @return A bit mask of the slots in the group at @a ctrl that are empty or deleted.
+  static unsigned match_free(uint8_t const *ctrl);
+
+  /// @return The slot index of an element equal to @a key with mixed hash @a h, or @c npos.
+  size_t find_slot(key_type key, uint64_t h) const;
+  /// @return The slot index of @a v, or @c npos.
+  size_t find_slot(value_type const *v) const;
+  /// Put @a v in a free slot of the index.
+  void place(value_type *v, uint64_t h);
+  /// Rebuild the index with @a n_groups groups.
+  void rehash(size_t n_groups);
+  /// Remove the element in slot @a idx from the index.
+  void clear_slot(size_t idx);
+
+  // noncopyable
+  IntrusiveFlatHashMap(const IntrusiveFlatHashMap &) = delete;
+  IntrusiveFlatHashMap &operator=(const IntrusiveFlatHashMap &) = delete;
+};
+
+// --- Implementation ---
+
+template <typename H> IntrusiveFlatHashMap<H>::IntrusiveFlatHashMap(size_t n) {
+  this->reserve(n);
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::hash_value(value_type *v) -> hash_id {
+  if constexpr (shadow::HASH_CACHE_P) {
+    return H::hash_cache(v);
+  } else {
+    return H::hash_of(H::key_of(v));
+  }
+}
+
+template <typename H>
+uint64_t
+IntrusiveFlatHashMap<H>::mix(hash_id h) {
+  // Murmur3 finalizer.
+  uint64_t x = h;
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdull;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ull;
+  return x ^ (x >> 33);
+}
+
+template <typename H>
+unsigned
+IntrusiveFlatHashMap<H>::match(uint8_t const *ctrl, uint8_t c) {
+#if defined(__SSE2__)
+  __m128i group = _mm_loadu_si128(reinterpret_cast<__m128i const *>(ctrl));
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(char(c))));
+#else
+  unsigned zret = 0;
+  for (unsigned i = 0; i < GROUP_WIDTH; ++i) {
+    zret |= unsigned(ctrl[i] == c) << i;
+  }
+  return zret;
+#endif
+}
+
+template <typename H>
+unsigned
+IntrusiveFlatHashMap<H>::match_free(uint8_t const *ctrl) {
+  // Both special values have the high bit set, and no hash bits do.
+#if defined(__SSE2__)
+  return _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const *>(ctrl)));
+#else
+  unsigned zret = 0;
+  for (unsigned i = 0; i < GROUP_WIDTH; ++i) {
+    zret |= unsigned(ctrl[i] >> 7) << i;
+  }
+  return zret;
+#endif
+}
+
+template <typename H>
+size_t
+IntrusiveFlatHashMap<H>::find_slot(key_type key, uint64_t h) const {
+  if (_ctrl.empty()) {
+    return npos;
+  }
+  uint8_t h2 = h & 0x7F;
+  // Triangular probing over a power of 2 number of groups visits every group.
+  for (size_t g = (h >> 7) & _group_mask, step = 0; step <= _group_mask; g = (g + ++step) & _group_mask) {
+    uint8_t const *ctrl = _ctrl.data() + g * GROUP_WIDTH;
+    for (unsigned m = match(ctrl, h2); m; m &= m - 1) {
+      size_t idx = g * GROUP_WIDTH + __builtin_ctz(m);
+      if (H::equal(key, H::key_of(_slots[idx]))) {
+        return idx;
+      }
+    }
+    if (match(ctrl, EMPTY)) {
+      break;
+    }
+  }
+  return npos;
+}
+
+template <typename H>
+size_t
+IntrusiveFlatHashMap<H>::find_slot(value_type const *v) const {
+  if (_ctrl.empty()) {
+    return npos;
+  }
+  auto vv    = const_cast<value_type *>(v);
+  uint64_t h = mix(hash_value(vv));
+  uint8_t h2 = h & 0x7F;
+  for (size_t g = (h >> 7) & _group_mask, step = 0; step <= _group_mask; g = (g + ++step) & _group_mask) {
+    uint8_t const *ctrl = _ctrl.data() + g * GROUP_WIDTH;
+    for (unsigned m = match(ctrl, h2); m; m &= m - 1) {
+      size_t idx = g * GROUP_WIDTH + __builtin_ctz(m);
+      if (_slots[idx] == vv) {
+        return idx;
+      }
+    }
+    if (match(ctrl, EMPTY)) {
+      break;
+    }
+  }
+  return npos;
+}
+
+template <typename H>
+void
+IntrusiveFlatHashMap<H>::place(value_type *v, uint64_t h) {
+  for (size_t g = (h >> 7) & _group_mask, step = 0;; g = (g + ++step) & _group_mask) {
+    uint8_t *ctrl = _ctrl.data() + g * GROUP_WIDTH;
+    if (unsigned m = match_free(ctrl); m) {
+      size_t idx = g * GROUP_WIDTH + __builtin_ctz(m);
+      if (_ctrl[idx] == DELETED) {
+        --_deleted;
+      }
+      _ctrl[idx]  = h & 0x7F;
+      _slots[idx] = v;
+      return;
+    }
+  }
+}
+
+template <typename H>
+void
+IntrusiveFlatHashMap<H>::rehash(size_t n_groups) {
+  _ctrl.assign(n_groups * GROUP_WIDTH, EMPTY);
+  _slots.assign(n_groups * GROUP_WIDTH, nullptr);
+  _group_mask = n_groups - 1;
+  _deleted    = 0;
+  for (auto &v : _list) {
+    this->place(&v, mix(hash_value(&v)));
+  }
+}
+
+template <typename H>
+void
+IntrusiveFlatHashMap<H>::clear_slot(size_t idx) {
+  // If the group has an empty slot, no probe continues past this group, and so this slot can be
+  // made empty. Otherwise a probe for another element may depend on this slot being occupied.
+  uint8_t const *ctrl = _ctrl.data() + (idx & ~(GROUP_WIDTH - 1));
+  if (match(ctrl, EMPTY)) {
+    _ctrl[idx] = EMPTY;
+  } else {
+    _ctrl[idx] = DELETED;
+    ++_deleted;
+  }
+  _slots[idx] = nullptr;
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::reserve(size_t n) -> self_type & {
+  // Keep the load factor below 7/8.
+  size_t n_groups = 1;
+  while (n_groups * GROUP_WIDTH * 7 / 8 < n) {
+    n_groups <<= 1;
+  }
+  if (n && n_groups * GROUP_WIDTH > _ctrl.size()) {
+    this->rehash(n_groups);
+  }
+  return *this;
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::clear() -> self_type & {
+  std::fill(_ctrl.begin(), _ctrl.end(), EMPTY);
+  std::fill(_slots.begin(), _slots.end(), nullptr);
+  _deleted = 0;
+  _list.clear();
+  return *this;
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::begin() -> iterator {
+  return _list.begin();
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::begin() const -> const_iterator {
+  return _list.begin();
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::end() -> iterator {
+  return _list.end();
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::end() const -> const_iterator {
+  return _list.end();
+}
+
+template <typename H>
+void
+IntrusiveFlatHashMap<H>::insert(value_type *v) {
+  if ((_list.count() + _deleted + 1) > _ctrl.size() * 7 / 8) {
+    // If enough of the used slots are deleted, rebuilding at the same size is sufficient.
+    size_t n_groups = _ctrl.size() / GROUP_WIDTH;
+    this->rehash(n_groups == 0 ? 1 : (_deleted > _list.count() ? n_groups : n_groups * 2));
+  }
+
+  auto key   = H::key_of(v);
+  hash_id hv = H::hash_of(key);
+  if constexpr (shadow::HASH_CACHE_P) {
+    H::hash_cache(v) = hv;
+  }
+  uint64_t h = mix(hv);
+
+  // Keep equal keys adjacent in the list, in order of insertion.
+  if (size_t idx = this->find_slot(key, h); idx != npos) {
+    value_type *spot = _slots[idx];
+    for (value_type *n; nullptr != (n = H::next_ptr(spot)) && H::equal(key, H::key_of(n));) {
+      spot = n;
+    }
+    _list.insert_after(spot, v);
+  } else {
+    _list.append(v);
+  }
+  this->place(v, h);
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::find(key_type key) -> iterator {
+  size_t idx = this->find_slot(key, mix(H::hash_of(key)));
+  if (idx == npos) {
+    return _list.end();
+  }
+  // Any of the equal elements may be found, back up to the first.
+  value_type *v = _slots[idx];
+  for (value_type *p; nullptr != (p = H::prev_ptr(v)) && H::equal(key, H::key_of(p));) {
+    v = p;
+  }
+  return _list.iterator_for(v);
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::find(key_type key) const -> const_iterator {
+  return const_cast<self_type *>(this)->find(key);
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::find(value_type *v) -> iterator {
+  return this->find_slot(v) == npos ? _list.end() : _list.iterator_for(v);
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::find(value_type const *v) const -> const_iterator {
+  return const_cast<self_type *>(this)->find(const_cast<value_type *>(v));
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::equal_range(key_type key) -> range {
+  iterator first{this->find(key)};
+  iterator last{first};
+  iterator limit{this->end()};
+
+  while (last != limit && H::equal(key, H::key_of(&*last))) {
+    ++last;
+  }
+
+  return range{first, last};
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::equal_range(key_type key) const -> const_range {
+  return const_cast<self_type *>(this)->equal_range(key);
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::iterator_for(value_type *v) -> iterator {
+  return _list.iterator_for(v);
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::iterator_for(value_type const *v) const -> const_iterator {
+  return _list.iterator_for(v);
+}
+
+template <typename H>
+auto
+IntrusiveFlatHashMap<H>::erase(iterator const &loc) -> iterator {
+  value_type *v = loc;
+  iterator zret = ++(this->iterator_for(v));
+  if (size_t idx = this->find_slot(v); idx != npos) {
+    this->clear_slot(idx);
+  }
+  _list.erase(v);
+  return zret;
+}
+
+template <typename H>
+bool
+IntrusiveFlatHashMap<H>::erase(value_type *value) {
+  if (size_t idx = this->find_slot(value); idx != npos) {
+    this->clear_slot(idx);
+    _list.erase(value);
+    return true;
+  }
+  return false;
+}
+
+template <typename H>
+template <typename F>
+auto
+IntrusiveFlatHashMap<H>::apply(F &&f) -> self_type & {
+  _list.apply(f);
+  return *this;
+}
+
+template <typename H>
+size_t
+IntrusiveFlatHashMap<H>::count() const {
+  return _list.count();
+}
+
+template <typename H>
+size_t
+IntrusiveFlatHashMap<H>::capacity() const {
+  return _ctrl.size();
+}
+
+}} // namespace swoc::SWOC_VERSION_NS
@@ -15,9 +15,62 @@
 #include <algorithm>
 
 #include "swoc/swoc_version.h"
+#include "swoc/swoc_meta.h"
 #include "swoc/IntrusiveDList.h"
+#include "swoc/bwf_base.h"
 
 namespace swoc { inline namespace SWOC_VERSION_NS {
+namespace detail {
+/// @{
+/// Detect optional descriptor members for @c IntrusiveHashMap.
+template <typename H, typename V>
+constexpr auto
+ihm_hash_cache_p(meta::CaseTag<0>) -> bool {
+  return false;
+}
+
+template <typename H, typename V>
+constexpr auto
+ihm_hash_cache_p(meta::CaseTag<1>) -> decltype(H::hash_cache(static_cast<V *>(nullptr)), bool()) {
+  return true;
+}
+
+template <typename H>
+constexpr auto
+ihm_multiply_shift_p(meta::CaseTag<0>) -> bool {
+  return false;
+}
+
+template <typename H>
+constexpr auto
+ihm_multiply_shift_p(meta::CaseTag<1>) -> decltype(H::MULTIPLY_SHIFT, bool()) {
+  return H::MULTIPLY_SHIFT;
+}
+/// @}
+} // namespace detail
+
+/** Distribution statistics for an @c IntrusiveHashMap.
+ *
+ * The probe lengths are computed from the chain lengths, on the presumption that lookups are for
+ * uniformly distributed keys. A probe is a key comparison, or skipping an element with a different
+ * cached hash value.
+ */
+struct IntrusiveHashMapStats {
+  /// Number of entries in the chain length histogram.
+  static constexpr size_t HISTOGRAM_SIZE = 8;
+
+  size_t _count        = 0; ///< Number of elements.
+  size_t _bucket_count = 0; ///< Number of buckets.
+  size_t _active_count = 0; ///< Number of non-empty buckets.
+  size_t _mixed_count  = 0; ///< Number of buckets with different keys.
+  size_t _max_length   = 0; ///< Longest chain.
+  size_t _expansions   = 0; ///< Number of expansions of the bucket array.
+  double _hit_probes   = 0; ///< Average number of probes to find an element in the map.
+  double _miss_probes  = 0; ///< Average number of probes for a key not in the map.
+  /// Number of buckets for each chain length. The last entry is for that length or longer.
+  std::array<size_t, HISTOGRAM_SIZE> _histogram{};
+};
+
 /** Intrusive Hash Table.
 
     Values stored in this container are not destroyed when the container is destroyed or removed from the container.
@@ -33,6 +86,11 @@ namespace swoc { inline namespace SWOC_VERSION_NS {
     @see @c setExpansionLimit()
     @see @c expand()
 
+    Expansion normally rebuilds the entire table in the call to @c insert that triggers it. If incremental expansion
+    is enabled, the new bucket array is allocated and the buckets are moved from the old array a few at a time in
+    subsequent calls to @c insert, which bounds the latency of any single insert.
+    @see @c set_incremental_expansion()
+
     The hash table is configured by a descriptor class. This must contain the following members
 
     - The static method <tt>key_type key_of(value_type *)</tt> which returns the key for an instance of @c value_type.
@@ -48,6 +106,17 @@ namespace swoc { inline namespace SWOC_VERSION_NS {
     These are the required members, it is permitted to have other methods (if the descriptor is used for other purposes)
     or to provide overloads of the methods. Note this is compatible with @c IntrusiveDList.
 
+    The descriptor may also have these optional members.
+
+    - The static method <tt>hash_id & hash_cache(value_type *)</tt> which returns a reference to storage in the
+      element for its hash value. The table sets this on insert, after which the element is never rehashed. During a
+      lookup, elements with a different hash value are skipped without calling @c equal.
+
+    - The constant <tt>static constexpr bool MULTIPLY_SHIFT</tt> which, if @c true, computes the bucket index by
+      multiplying the hash value by the number of buckets and keeping the high bits, instead of an integer modulus.
+      This is much faster but uses only the high bits of the hash value, which must therefore be well mixed. In
+      particular, it should not be used with an identity hash such as <tt>std::hash<int></tt>.
+
     Several internal types are deduced from these arguments.
 
     @a Key is the return type of @a key_of and represents the key that distinguishes instances of @a value_type. Two
@@ -82,6 +151,11 @@ public:
   /// The numeric hash ID computed from a key.
   using hash_id = decltype(H::hash_of(H::key_of(static_cast<value_type *>(nullptr))));
 
+  /// Descriptor provides storage for the hash value in the element.
+  static constexpr bool HASH_CACHE_P = detail::ihm_hash_cache_p<H, value_type>(meta::CaseArg);
+  /// Bucket index is computed by multiply and shift.
+  static constexpr bool MULTIPLY_SHIFT_P = detail::ihm_multiply_shift_p<H>(meta::CaseArg);
+
   /// When the hash table is expanded.
   enum ExpansionPolicy {
     MANUAL,  ///< Client must explicitly expand the table.
@@ -196,6 +270,19 @@ public:
   */
   void insert(value_type *v);
 
+  /** Insert a sequence of values in to the table.
+
+      @tparam I Iterator type, which must dereference to a pointer to @c value_type.
+      @param first First value.
+      @param last Past the last value.
+
+      Unless the expansion policy is @c MANUAL, the table is first expanded to hold all of the values, instead of
+      repeatedly during the insertions. The values are then sorted by bucket before being linked, so that each bucket is
+      filled at once, which has much better memory locality for large sequences. Values with equal keys remain in the same
+      order as in the sequence.
+  */
+  template <typename I> void insert(I first, I last);
+
   /** Find an element with a key equal to @a key.
 
       @return A element with a matching key, or the end iterator if not found.
@@ -260,9 +347,21 @@ public:
    */
   template <typename F> self_type &apply(F &&f);
 
+  /** Make sure the table has enough buckets for @a n elements.
+
+      @param n Number of elements.
+      @return @a this
+
+      The number of buckets is made large enough that the average chain length will not exceed the expansion limit with
+      @a n elements, so that automatic expansion is not triggered by the @c AVERAGE policy. This is done immediately,
+      regardless of the policy or incremental expansion.
+   */
+  self_type &reserve(size_t n);
+
   /** Expand the hash if needed.
 
-      Useful primarily when the expansion policy is set to @c MANUAL.
+      Useful primarily when the expansion policy is set to @c MANUAL. This always completes the expansion, including
+      any incremental expansion in progress.
    */
   void expand();
 
@@ -284,6 +383,32 @@ public:
   /// Set the limit value for the expansion policy.
   size_t get_expansion_limit() const;
 
+  /** Compute distribution statistics.
+   *
+   * @return The statistics for the current state of the map.
+   *
+   * This walks the active buckets, and so is linear in the number of elements.
+   */
+  IntrusiveHashMapStats stats() const;
+
+  /** Set incremental expansion.
+
+      @param flag @c true to expand incrementally, @c false to expand all at once.
+      @return @a this
+
+      If enabled, an automatic expansion keeps the old bucket array and moves @c MIGRATION_STEP buckets to the new
+      array on each subsequent @c insert until all of them are moved. Lookup and erase work correctly during this
+      migration, but the order of elements may change on any @c insert, as it already can when the table expands.
+      Disabling this does not interrupt a migration in progress.
+   */
+  self_type &set_incremental_expansion(bool flag);
+
+  /// Get the incremental expansion flag.
+  bool get_incremental_expansion() const;
+
+  /// Number of old buckets moved per @c insert during an incremental expansion.
+  static constexpr size_t MIGRATION_STEP = 8;
+
 protected:
   /// The type of storage for the buckets.
   using Table = std::vector<Bucket>;
@@ -291,13 +416,45 @@ protected:
   List _list;   ///< Elements in the table.
   Table _table; ///< Array of buckets.
 
+  /// Array of buckets being migrated to @a _table. Empty unless an incremental expansion is in progress.
+  Table _old_table;
+  /// Index of the next bucket in @a _old_table to migrate. Buckets before this are empty.
+  size_t _migration_idx{0};
+
   /// List of non-empty buckets.
   IntrusiveDList<typename Bucket::Linkage> _active_buckets;
 
   Bucket *bucket_for(key_type key);
 
+  /// @return The bucket for the hash value @a h.
+  Bucket *bucket_for_hash(hash_id h);
+
+  /// @return The index of the bucket for hash value @a h in a table of @a n buckets.
+  static size_t index_of(hash_id h, size_t n);
+
+  /// @return The hash value of @a v, from the cache if available.
+  static hash_id hash_value(value_type *v);
+
+  /// @return @c false if @a v is known to not have the hash value @a h, @c true otherwise.
+  static bool hash_match(value_type *v, hash_id h);
+
+  /// Put @a v, with hash value @a h, in to its bucket without checking for expansion.
+  /// @return The bucket for @a v.
+  Bucket *link(value_type *v, hash_id h);
+
+  /// Start an incremental expansion.
+  void start_migration();
+
+  /// Move up to @a n buckets from @a _old_table to @a _table.
+  void migrate(size_t n);
+
+  /// Rebuild the table with @a n buckets, which must be more than the current number.
+  void rehash(size_t n);
+
   ExpansionPolicy _expansion_policy{DEFAULT_EXPANSION_POLICY}; ///< When to exand the table.
   size_t _expansion_limit{DEFAULT_EXPANSION_LIMIT};            ///< Limit value for expansion.
+  bool _incremental_p{false};                                  ///< Expand incrementally.
+  size_t _expansions{0};                                       ///< Number of expansions.
 
   // noncopyable
   IntrusiveHashMap(const IntrusiveHashMap &) = delete;
@@ -389,7 +546,53 @@ template <typename H> IntrusiveHashMap<H>::IntrusiveHashMap(size_t n) {
 template <typename H>
 auto
 IntrusiveHashMap<H>::bucket_for(key_type key) -> Bucket * {
-  return &_table[H::hash_of(key) % _table.size()];
+  return this->bucket_for_hash(H::hash_of(key));
+}
+
+template <typename H>
+auto
+IntrusiveHashMap<H>::bucket_for_hash(hash_id h) -> Bucket * {
+  // During a migration a key is in the old table unless its old bucket has already been moved.
+  if (!_old_table.empty()) {
+    if (size_t idx = index_of(h, _old_table.size()); idx >= _migration_idx) {
+      return &_old_table[idx];
+    }
+  }
+  return &_table[index_of(h, _table.size())];
+}
+
+template <typename H>
+size_t
+IntrusiveHashMap<H>::index_of(hash_id h, size_t n) {
+  if constexpr (MULTIPLY_SHIFT_P) {
+    if constexpr (sizeof(hash_id) <= sizeof(uint32_t)) {
+      return (uint64_t(uint32_t(h)) * n) >> 32;
+    } else {
+      return (__uint128_t(uint64_t(h)) * n) >> 64;
+    }
+  } else {
+    return h % n;
+  }
+}
+
+template <typename H>
+auto
+IntrusiveHashMap<H>::hash_value(value_type *v) -> hash_id {
+  if constexpr (HASH_CACHE_P) {
+    return H::hash_cache(v);
+  } else {
+    return H::hash_of(H::key_of(v));
+  }
+}
+
+template <typename H>
+bool
+IntrusiveHashMap<H>::hash_match(value_type *v, hash_id h) {
+  if constexpr (HASH_CACHE_P) {
+    return H::hash_cache(v) == h;
+  } else {
+    return true;
+  }
 }
 
 template <typename H>
@@ -422,6 +625,8 @@ IntrusiveHashMap<H>::clear() -> self_type & {
   for (auto &b : _table) {
     b.clear();
   }
+  Table().swap(_old_table);
+  _migration_idx = 0;
   // Clear container data.
   _list.clear();
   _active_buckets.clear();
@@ -431,10 +636,11 @@ IntrusiveHashMap<H>::clear() -> self_type & {
 template <typename H>
 auto
 IntrusiveHashMap<H>::find(key_type key) -> iterator {
-  Bucket *b         = this->bucket_for(key);
+  hash_id h         = H::hash_of(key);
+  Bucket *b         = this->bucket_for_hash(h);
   value_type *v     = b->_v;
   value_type *limit = b->limit();
-  while (v != limit && !H::equal(key, H::key_of(v))) {
+  while (v != limit && !(hash_match(v, h) && H::equal(key, H::key_of(v)))) {
     v = H::next_ptr(v);
   }
   return v == limit ? _list.end() : _list.iterator_for(v);
@@ -481,7 +687,8 @@ IntrusiveHashMap<H>::iterator_for(value_type *v) -> iterator {
 template <typename H>
 auto
 IntrusiveHashMap<H>::find(value_type *v) -> iterator {
-  Bucket *b = this->bucket_for(H::key_of(v));
+  // If @a v is not in the table a stale cached hash value may select the wrong bucket, but then it's not found anyway.
+  Bucket *b = this->bucket_for_hash(hash_value(v));
   return b->contains(v) ? _list.iterator_for(v) : this->end();
 }
 
@@ -494,8 +701,32 @@ IntrusiveHashMap<H>::find(value_type const *v) const -> const_iterator {
 template <typename H>
 void
 IntrusiveHashMap<H>::insert(value_type *v) {
+  if (!_old_table.empty()) {
+    this->migrate(MIGRATION_STEP);
+  }
+
+  hash_id h = H::hash_of(H::key_of(v));
+  if constexpr (HASH_CACHE_P) {
+    H::hash_cache(v) = h;
+  }
+  Bucket *bucket = this->link(v, h);
+
+  // auto expand if appropriate. This is not done while migrating, which will finish well before it is needed.
+  if (_old_table.empty() && ((AVERAGE == _expansion_policy && (_list.count() / _table.size()) > _expansion_limit) ||
+                             (MAXIMUM == _expansion_policy && bucket->_count > _expansion_limit && bucket->_mixed_p))) {
+    if (_incremental_p) {
+      this->start_migration();
+    } else {
+      this->expand();
+    }
+  }
+}
+
+template <typename H>
+auto
+IntrusiveHashMap<H>::link(value_type *v, hash_id h) -> Bucket * {
   auto key         = H::key_of(v);
-  Bucket *bucket   = this->bucket_for(key);
+  Bucket *bucket   = this->bucket_for_hash(h);
   value_type *spot = bucket->_v;
   bool mixed_p     = false; // Found a different key in the bucket.
 
@@ -507,7 +738,7 @@ IntrusiveHashMap<H>::insert(value_type *v) {
     value_type *limit = bucket->limit();
 
     // First search the bucket to see if the key is already in it.
-    while (spot != limit && !H::equal(key, H::key_of(spot))) {
+    while (spot != limit && !(hash_match(spot, h) && H::equal(key, H::key_of(spot)))) {
       spot = H::next_ptr(spot);
     }
     if (spot != bucket->_v) {
@@ -517,7 +748,7 @@ IntrusiveHashMap<H>::insert(value_type *v) {
       // If an equal key was found, walk past those to insert at the upper end of the range.
       do {
         spot = H::next_ptr(spot);
-      } while (spot != limit && H::equal(key, H::key_of(spot)));
+      } while (spot != limit && hash_match(spot, h) && H::equal(key, H::key_of(spot)));
       if (spot != limit) { // something not equal past last equivalent, it's going to be mixed.
         mixed_p = true;
       }
@@ -530,12 +761,7 @@ IntrusiveHashMap<H>::insert(value_type *v) {
     bucket->_mixed_p = mixed_p;
   }
   ++bucket->_count;
-
-  // auto expand if appropriate.
-  if ((AVERAGE == _expansion_policy && (_list.count() / _table.size()) > _expansion_limit) ||
-      (MAXIMUM == _expansion_policy && bucket->_count > _expansion_limit && bucket->_mixed_p)) {
-    this->expand();
-  }
+  return bucket;
 }
 
 template <typename H>
@@ -543,17 +769,17 @@ auto
 IntrusiveHashMap<H>::erase(iterator const &loc) -> iterator {
   value_type *v     = loc;
   iterator zret     = ++(this->iterator_for(v)); // get around no const_iterator -> iterator.
-  Bucket *b         = this->bucket_for(H::key_of(v));
+  Bucket *b         = this->bucket_for_hash(hash_value(v));
   value_type *nv    = H::next_ptr(v);
   value_type *limit = b->limit();
-  if (b->_v == v) {    // removed first element in bucket, update bucket
-    if (limit == nv) { // that was also the only element, deactivate bucket
-      _active_buckets.erase(b);
-      b->clear();
-    } else {
+  if (b->_v == v && limit == nv) { // only element in the bucket, deactivate bucket
+    _active_buckets.erase(b);
+    b->clear();
+  } else {
+    if (b->_v == v) { // removed first element in bucket, update bucket
       b->_v = nv;
-      --b->_count;
     }
+    --b->_count;
   }
   _list.erase(loc);
   return zret;
@@ -573,22 +799,12 @@ IntrusiveHashMap<H>::erase(value_type *value) {
 template <typename H>
 auto
 IntrusiveHashMap<H>::erase(iterator const &start, iterator const &limit) -> iterator {
+  // Elements are removed one at a time so that every bucket is updated correctly.
   auto spot{start};
-  Bucket *bucket{this->bucket_for(spot)};
   while (spot != limit) {
-    auto target         = bucket;
-    bucket              = bucket->_link._next; // bump now to avoid forward iteration problems in case of bucket removal.
-    value_type *v_limit = bucket ? bucket->_v : nullptr;
-    while (spot != v_limit && spot != limit) {
-      --(target->_count);
-      ++spot;
-    }
-    if (target->_count == 0) {
-      _active_buckets.erase(target);
-    }
+    spot = this->erase(spot);
   }
-  _list.erase(start, limit);
-  return _list.iterator_for(limit); // convert from const_iterator back to iterator
+  return spot;
 };
 
 template <typename H>
@@ -634,22 +850,113 @@ IntrusiveHashMap<H>::apply(F &&f) -> self_type & {
 template <typename H>
 void
 IntrusiveHashMap<H>::expand() {
-  ExpansionPolicy org_expansion_policy = _expansion_policy; // save for restore.
-  value_type *old                      = _list.head();      // save for repopulating.
-  auto old_size                        = _table.size();
+  this->rehash(*std::lower_bound(PRIME.begin(), PRIME.end(), _table.size() + 1));
+}
+
+template <typename H>
+auto
+IntrusiveHashMap<H>::reserve(size_t n) -> self_type & {
+  size_t limit = std::max<size_t>(1, _expansion_limit);
+  size_t want  = (n + limit - 1) / limit;
+  if (want > _table.size()) {
+    this->rehash(*std::lower_bound(PRIME.begin(), PRIME.end() - 1, want));
+  }
+  return *this;
+}
+
+template <typename H>
+template <typename I>
+void
+IntrusiveHashMap<H>::insert(I first, I last) {
+  struct Entry {
+    size_t _idx;    ///< Bucket index.
+    hash_id _hash;  ///< Hash value.
+    value_type *_v; ///< Value.
+  };
+  std::vector<Entry> entries;
+
+  for (; first != last; ++first) {
+    value_type *v = *first;
+    hash_id h     = H::hash_of(H::key_of(v));
+    if constexpr (HASH_CACHE_P) {
+      H::hash_cache(v) = h;
+    }
+    entries.push_back({0, h, v});
+  }
+
+  if (MANUAL != _expansion_policy) {
+    this->reserve(_list.count() + entries.size());
+  }
+  if (!_old_table.empty()) { // Bucket indices must be for @a _table.
+    this->migrate(_old_table.size());
+  }
+  for (auto &entry : entries) {
+    entry._idx = index_of(entry._hash, _table.size());
+  }
+  std::stable_sort(entries.begin(), entries.end(), [](Entry const &lhs, Entry const &rhs) { return lhs._idx < rhs._idx; });
+  for (auto &entry : entries) {
+    this->link(entry._v, entry._hash);
+  }
+}
 
-  // Reset to empty state.
+template <typename H>
+void
+IntrusiveHashMap<H>::rehash(size_t n) {
+  value_type *old = _list.head(); // save for repopulating.
+
+  ++_expansions;
+  // Reset to empty state. This discards any migration in progress, which is fine as every element is re-linked.
+  // If the hash values are cached, no key is rehashed.
   this->clear();
-  _table.resize(*std::lower_bound(PRIME.begin(), PRIME.end(), old_size + 1));
+  _table.resize(n);
 
-  _expansion_policy = MANUAL; // disable any auto expand while we're expanding.
   while (old) {
     value_type *v = old;
     old           = H::next_ptr(old);
-    this->insert(v);
+    this->link(v, hash_value(v));
+  }
+}
+
+template <typename H>
+void
+IntrusiveHashMap<H>::start_migration() {
+  auto old_size = _table.size();
+  // Moving the vector keeps the bucket addresses, so the active bucket list remains valid.
+  _old_table = std::move(_table);
+  _table     = Table(*std::lower_bound(PRIME.begin(), PRIME.end(), old_size + 1));
+  _migration_idx = 0;
+  ++_expansions;
+}
+
+template <typename H>
+void
+IntrusiveHashMap<H>::migrate(size_t n) {
+  List tmp;
+  for (size_t limit = std::min(_old_table.size(), _migration_idx + n); _migration_idx < limit;) {
+    Bucket *b = &_old_table[_migration_idx++]; // bump first so @c bucket_for uses the new table for these keys.
+    if (nullptr == b->_v) {
+      continue;
+    }
+    // The elements must be removed from the list before the bucket is deactivated, or they would appear to be in
+    // the previous active bucket.
+    value_type *v       = b->_v;
+    value_type *v_limit = b->limit();
+    while (v != v_limit) {
+      value_type *next = H::next_ptr(v);
+      _list.erase(v);
+      tmp.append(v);
+      v = next;
+    }
+    _active_buckets.erase(b);
+    b->clear();
+    while (nullptr != (v = tmp.take_head())) {
+      this->link(v, hash_value(v));
+    }
+  }
+  if (_migration_idx >= _old_table.size()) {
+    Table().swap(_old_table);
+    _migration_idx = 0;
   }
-  // stashed array gets cleaned up when @a tmp goes out of scope.
-  _expansion_policy = org_expansion_policy; // reset to original value.
 }
 
 template <typename H>
@@ -690,4 +997,60 @@ IntrusiveHashMap<H>::get_expansion_limit() const {
   return _expansion_limit;
 }
 
+template <typename H>
+IntrusiveHashMapStats
+IntrusiveHashMap<H>::stats() const {
+  IntrusiveHashMapStats zret;
+  size_t probes = 0; // Total probes to find every element.
+
+  zret._count        = _list.count();
+  zret._bucket_count = _table.size() + _old_table.size() - _migration_idx;
+  zret._expansions   = _expansions;
+  for (auto const &b : _active_buckets) {
+    ++zret._active_count;
+    zret._mixed_count += b._mixed_p;
+    zret._max_length   = std::max(zret._max_length, b._count);
+    ++zret._histogram[std::min(b._count, zret._histogram.size() - 1)];
+    probes += b._count * (b._count + 1) / 2;
+  }
+  zret._histogram[0] = zret._bucket_count - zret._active_count;
+  if (zret._count) {
+    zret._hit_probes = double(probes) / zret._count;
+  }
+  if (zret._bucket_count) {
+    zret._miss_probes = double(zret._count) / zret._bucket_count;
+  }
+  return zret;
+}
+
+template <typename H>
+auto
+IntrusiveHashMap<H>::set_incremental_expansion(bool flag) -> self_type & {
+  _incremental_p = flag;
+  return *this;
+}
+
+template <typename H>
+bool
+IntrusiveHashMap<H>::get_incremental_expansion() const {
+  return _incremental_p;
+}
+
+/** Format hash map statistics.
+ *
+ * The statistics are printed as "name=value" pairs, with the histogram last.
+ */
+inline BufferWriter &
+bwformat(BufferWriter &w, bwf::Spec const &, IntrusiveHashMapStats const &stats) {
+  w.print("count={} buckets={} active={} mixed={} max={} expansions={} hit={:.2} miss={:.2} histogram=", stats._count,
+          stats._bucket_count, stats._active_count, stats._mixed_count, stats._max_length, stats._expansions,
+          stats._hit_probes, stats._miss_probes);
+  char sep = '[';
+  for (auto n : stats._histogram) {
+    w.print("{}{}", sep, n);
+    sep = ',';
+  }
+  return w.write(']');
+}
+
 }} // namespace swoc::SWOC_VERSION_NS
@@ -0,0 +1,150 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Apache Software Foundation 2019
+/** @file
+
+  Intrusive lock free multiple producer / single consumer queue.
+
+  Items are passed between threads using links in the items, the same as @c IntrusiveDList.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+#include "swoc/swoc_version.h"
+#include "swoc/IntrusiveDList.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+/** Intrusive lock free multiple producer / single consumer queue.
+
+    @tparam L Linkage descriptor, the same as for @c IntrusiveDList.
+
+    Any number of threads can push items while a single thread consumes them. No memory is allocated
+    and no locks are used. A push is a single compare and swap on the queue head, and the consumer
+    takes all of the pushed items at once with a single exchange. The items are then returned in the
+    order they were pushed. Only the @c next_ptr link is used while an item is in the queue, the
+    @c prev_ptr link is used only when the items are handed to the consumer in an @c IntrusiveDList.
+
+    @code
+      swoc::IntrusiveMPSCQueue<Job::Linkage> queue;
+      // In any thread.
+      if (queue.push(job)) {
+        // queue was empty, wake the consumer.
+      }
+      // In the consumer thread.
+      for (auto &job : queue.take_all()) {
+        job.run();
+      }
+    @endcode
+
+    Because the consumer never removes a single item from the shared part of the queue, there is no
+    ABA problem.
+
+    @note Only one thread may call the consumer methods (@c take_all, @c take) at a time.
+ */
+template <typename L> class IntrusiveMPSCQueue {
+  using self_type = IntrusiveMPSCQueue; ///< Self reference type.
+
+public:
+  /// List type used to return items to the consumer.
+  using list_type = IntrusiveDList<L>;
+  /// Type of items in the queue.
+  using value_type = typename list_type::value_type;
+
+  /// Default constructor.
+  IntrusiveMPSCQueue() = default;
+
+  /// No copying.
+  IntrusiveMPSCQueue(self_type const &) = delete;
+  /// No copying.
+  self_type &operator=(self_type const &) = delete;
+
+  /** Add an item to the queue.
+
+      @param v Item to add.
+      @return @c true if the queue was empty, @c false otherwise.
+
+      This can be called from any thread. The return value can be used to decide whether the
+      consumer needs to be woken. @a v must not already be in the queue or another list that uses
+      the same links.
+   */
+  bool push(value_type *v);
+
+  /** Take all items in the queue.
+
+      @return The items, in the order they were pushed.
+
+      This must be called only from the consumer thread.
+   */
+  list_type take_all();
+
+  /** Take the next item in the queue.
+
+      @return The item pushed earliest, or @c nullptr if the queue is empty.
+
+      This must be called only from the consumer thread. Items are taken from the shared queue in
+      batches and then handed out one at a time.
+   */
+  value_type *take();
+
+  /** Check if the queue is empty.
+
+      @return @c true if there are no items in the queue, @c false otherwise.
+
+      This is exact only if called from the consumer thread, and even then an item may be pushed
+      immediately after.
+   */
+  bool empty() const;
+
+protected:
+  /// Most recently pushed item, linked to earlier items.
+  /// Aligned so that producers do not contend with the consumer's local state.
+  alignas(64) std::atomic<value_type *> _head{nullptr};
+  /// Items taken from @a _head but not yet returned by @c take. Used only by the consumer.
+  list_type _local;
+};
+
+// --- Implementation ---
+
+template <typename L>
+bool
+IntrusiveMPSCQueue<L>::push(value_type *v) {
+  // Once @a v is in the queue the consumer may change its links, so use a local copy of the head.
+  value_type *head = _head.load(std::memory_order_relaxed);
+  do {
+    L::next_ptr(v) = head;
+  } while (!_head.compare_exchange_weak(head, v, std::memory_order_release, std::memory_order_relaxed));
+  return nullptr == head;
+}
+
+template <typename L>
+auto
+IntrusiveMPSCQueue<L>::take_all() -> list_type {
+  list_type zret;
+  // The chain is newest first, prepending each item restores the push order.
+  for (value_type *v = _head.exchange(nullptr, std::memory_order_acquire), *next; v; v = next) {
+    next = L::next_ptr(v);
+    zret.prepend(v);
+  }
+  // Anything left from a previous batch was pushed earlier.
+  _local.splice(_local.end(), zret);
+  return std::move(_local);
+}
+
+template <typename L>
+auto
+IntrusiveMPSCQueue<L>::take() -> value_type * {
+  if (_local.empty()) {
+    _local = this->take_all();
+  }
+  return _local.take_head();
+}
+
+template <typename L>
+bool
+IntrusiveMPSCQueue<L>::empty() const {
+  return _local.empty() && nullptr == _head.load(std::memory_order_relaxed);
+}
+
+}} // namespace swoc::SWOC_VERSION_NS
@@ -0,0 +1,323 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Apache Software Foundation 2019
+/** @file
+
+  Intrusive pairing heap.
+
+  A priority queue using links in the elements, in the style of @c IntrusiveDList.
+
+  @note This is a header only library.
+*/
+
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include "swoc/swoc_version.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+/** Intrusive pairing heap.
+
+    @tparam H Element access descriptor.
+
+    This is a min heap - the top element is the one with the smallest key. Elements are linked in
+    to a tree using links in the elements, so no memory is allocated. Inserting an element and
+    merging heaps is constant time. Removing the top element or an arbitrary element is amortized
+    logarithmic time.
+
+    The descriptor @a H must have these static members.
+
+    - @c child_ptr Return a reference to the pointer to the first child element.
+    - @c next_ptr Return a reference to the pointer to the next sibling element.
+    - @c prev_ptr Return a reference to the pointer to the previous sibling, or the parent for a first
+      child.
+    - @c key_of Return the key for an element.
+    - @c less Compare two keys, returning @c true if the first is less than the second.
+
+    The pointer methods take a single argument of @c Element* and must return a reference to a
+    pointer. The element type is deduced from @c next_ptr. The links should be initialized to
+    @c nullptr.
+
+    @code
+      struct Timer {
+        uint64_t _expiry;
+        Timer * _child = nullptr;
+        Timer * _next = nullptr;
+        Timer * _prev = nullptr;
+
+        struct Descriptor {
+          static Timer *& child_ptr(Timer * t) { return t->_child; }
+          static Timer *& next_ptr(Timer * t) { return t->_next; }
+          static Timer *& prev_ptr(Timer * t) { return t->_prev; }
+          static uint64_t key_of(Timer * t) { return t->_expiry; }
+          static bool less(uint64_t lhs, uint64_t rhs) { return lhs < rhs; }
+        };
+      };
+
+      swoc::IntrusivePairingHeap<Timer::Descriptor> heap;
+    @endcode
+ */
+template <typename H> class IntrusivePairingHeap {
+  using self_type = IntrusivePairingHeap; ///< Self reference type.
+
+public:
+  /// Type of elements in the heap.
+  using value_type = typename std::remove_pointer<typename std::remove_reference<decltype(H::next_ptr(nullptr))>::type>::type;
+
+  /// Default constructor.
+  IntrusivePairingHeap() = default;
+
+  /// No copying, elements can't be in two heaps.
+  IntrusivePairingHeap(self_type const &) = delete;
+  /// No copying, elements can't be in two heaps.
+  self_type &operator=(self_type const &) = delete;
+
+  /// Move constructor, @a that is left empty.
+  IntrusivePairingHeap(self_type &&that);
+  /// Move assignment, @a that is left empty.
+  self_type &operator=(self_type &&that);
+
+  /** Add an element.
+
+      @param v Element to add.
+      @return @a this
+
+      This is constant time.
+   */
+  self_type &insert(value_type *v);
+
+  /// @return The element with the smallest key, or @c nullptr if the heap is empty.
+  value_type *top() const;
+
+  /** Remove the top element.
+
+      @return The element with the smallest key, or @c nullptr if the heap is empty.
+   */
+  value_type *take_top();
+
+  /** Remove an element.
+
+      @param v Element to remove.
+      @return @a this
+
+      @a v must be in this heap.
+   */
+  self_type &erase(value_type *v);
+
+  /** Restore the heap order after the key of an element has changed.
+
+      @param v Element with the changed key.
+      @return @a this
+
+      This is the same as erasing and inserting @a v. Because there are no parent links, the
+      direction of the change can't be checked cheaply and so isn't used.
+   */
+  self_type &update(value_type *v);
+
+  /** Move all elements of @a that to this heap.
+
+      @param that Source heap.
+      @return @a this
+
+      This is constant time. @a that is left empty.
+   */
+  self_type &merge(self_type &that);
+
+  /** Remove all elements.
+
+      @return @a this
+
+      The elements are not changed, their links must be reset before they are reused.
+   */
+  self_type &clear();
+
+  /// @return The number of elements in the heap.
+  size_t count() const;
+
+  /// @return @c true if the heap is empty, @c false otherwise.
+  bool empty() const;
+
+protected:
+  value_type *_root = nullptr; ///< Top element.
+  size_t _count     = 0;       ///< Number of elements.
+
+  /// Combine two trees, returning the new root.
+  static value_type *meld(value_type *a, value_type *b);
+
+  /// Combine a list of sibling trees in to a single tree using the two pass method.
+  static value_type *merge_pairs(value_type *first);
+
+  /// Remove @a v (and its subtree) from the list of siblings it is in.
+  static void cut(value_type *v);
+};
+
+// --- Implementation ---
+
+template <typename H> IntrusivePairingHeap<H>::IntrusivePairingHeap(self_type &&that) : _root(that._root), _count(that._count) {
+  that.clear();
+}
+
+template <typename H>
+auto
+IntrusivePairingHeap<H>::operator=(self_type &&that) -> self_type & {
+  if (this != &that) {
+    _root  = that._root;
+    _count = that._count;
+    that.clear();
+  }
+  return *this;
+}
+
+template <typename H>
+auto
+IntrusivePairingHeap<H>::meld(value_type *a, value_type *b) -> value_type * {
+  if (H::less(H::key_of(b), H::key_of(a))) {
+    std::swap(a, b);
+  }
+  // @a b becomes the first child of @a a.
+  value_type *&child = H::child_ptr(a);
+  H::next_ptr(b)     = child;
+  H::prev_ptr(b)     = a;
+  if (child) {
+    H::prev_ptr(child) = b;
+  }
+  child = b;
+  return a;
+}
+
+template <typename H>
+auto
+IntrusivePairingHeap<H>::merge_pairs(value_type *first) -> value_type * {
+  if (nullptr == first) {
+    return nullptr;
+  }
+
+  // First pass - meld pairs left to right, stacking the results using the next links.
+  value_type *stack = nullptr;
+  while (first) {
+    value_type *a = first;
+    value_type *b = H::next_ptr(a);
+    first         = b ? H::next_ptr(b) : nullptr;
+    H::next_ptr(a) = H::prev_ptr(a) = nullptr;
+    if (b) {
+      H::next_ptr(b) = H::prev_ptr(b) = nullptr;
+      a              = meld(a, b);
+    }
+    H::next_ptr(a) = stack;
+    stack          = a;
+  }
+
+  // Second pass - meld the results right to left.
+  value_type *zret = stack;
+  stack            = H::next_ptr(zret);
+  H::next_ptr(zret) = nullptr;
+  while (stack) {
+    value_type *t = stack;
+    stack         = H::next_ptr(t);
+    H::next_ptr(t) = nullptr;
+    zret           = meld(zret, t);
+  }
+  return zret;
+}
+
+template <typename H>
+void
+IntrusivePairingHeap<H>::cut(value_type *v) {
+  value_type *prev = H::prev_ptr(v);
+  value_type *next = H::next_ptr(v);
+  if (H::child_ptr(prev) == v) { // first child, @a prev is the parent.
+    H::child_ptr(prev) = next;
+  } else {
+    H::next_ptr(prev) = next;
+  }
+  if (next) {
+    H::prev_ptr(next) = prev;
+  }
+  H::next_ptr(v) = H::prev_ptr(v) = nullptr;
+}
+
+template <typename H>
+auto
+IntrusivePairingHeap<H>::insert(value_type *v) -> self_type & {
+  H::child_ptr(v) = H::next_ptr(v) = H::prev_ptr(v) = nullptr;
+  _root = _root ? meld(_root, v) : v;
+  ++_count;
+  return *this;
+}
+
+template <typename H>
+auto
+IntrusivePairingHeap<H>::top() const -> value_type * {
+  return _root;
+}
+
+template <typename H>
+auto
+IntrusivePairingHeap<H>::take_top() -> value_type * {
+  value_type *zret = _root;
+  if (zret) {
+    _root = merge_pairs(H::child_ptr(zret));
+    H::child_ptr(zret) = nullptr;
+    --_count;
+  }
+  return zret;
+}
+
+template <typename H>
+auto
+IntrusivePairingHeap<H>::erase(value_type *v) -> self_type & {
+  if (v == _root) {
+    this->take_top();
+  } else {
+    cut(v);
+    if (value_type *sub = merge_pairs(H::child_ptr(v)); sub) {
+      _root = meld(_root, sub);
+    }
+    H::child_ptr(v) = nullptr;
+    --_count;
+  }
+  return *this;
+}
+
+template <typename H>
+auto
+IntrusivePairingHeap<H>::update(value_type *v) -> self_type & {
+  if (v == _root && nullptr == H::child_ptr(v)) {
+    return *this; // nothing to be out of order with.
+  }
+  return this->erase(v).insert(v);
+}
+
+template <typename H>
+auto
+IntrusivePairingHeap<H>::merge(self_type &that) -> self_type & {
+  if (this != &that && that._root) {
+    _root = _root ? meld(_root, that._root) : that._root;
+    _count += that._count;
+    that.clear();
+  }
+  return *this;
+}
+
+template <typename H>
+auto
+IntrusivePairingHeap<H>::clear() -> self_type & {
+  _root  = nullptr;
+  _count = 0;
+  return *this;
+}
+
+template <typename H>
+size_t
+IntrusivePairingHeap<H>::count() const {
+  return _count;
+}
+
+template <typename H>
+bool
+IntrusivePairingHeap<H>::empty() const {
+  return nullptr == _root;
+}
+
+}} // namespace swoc::SWOC_VERSION_NS
@@ -13,12 +13,18 @@
 #include <functional>
 #include <array>
 #include <variant>
+#include <vector>
+#include <type_traits>
+#include <utility>
+#include <stdexcept>
+#include <limits>
+#include <algorithm>
 
 #include "swoc/swoc_version.h"
 #include "swoc/IntrusiveHashMap.h"
 #include "swoc/MemArena.h"
 #include "swoc/bwf_base.h"
-#include "swoc/ext/HashFNV.h"
+#include "swoc/ext/HashWy.h"
 
 namespace swoc { inline namespace SWOC_VERSION_NS {
 namespace detail {
@@ -370,7 +376,7 @@ protected:
 
       static std::string_view key_of(Item *);
 
-      static uint32_t hash_of(std::string_view s);
+      static uint64_t hash_of(std::string_view s);
 
       static bool equal(std::string_view const &lhs, std::string_view const &rhs);
     } _name_link;
@@ -395,16 +401,146 @@ protected:
   /// Copy @a name in to local storage.
   std::string_view localize(std::string_view const &name);
 
+  /// Values can be used as array indices.
+  static constexpr bool INDEXABLE = std::is_integral_v<E> || std::is_enum_v<E>;
+
+  /** Add a primary name to the value index.
+   *
+   * @param item The item with the primary name.
+   *
+   * The index is used only while the values are dense - most of the range between the minimum and
+   * maximum values has a value defined. If not, the index is dropped and the hash map is used.
+   */
+  void index_value(Item *item);
+
   /// Storage for names.
   MemArena _arena{1024};
   /// Access by name.
   IntrusiveHashMap<typename Item::NameLinkage> _by_name;
   /// Access by value.
   IntrusiveHashMap<typename Item::ValueLinkage> _by_value;
+  /// Access by value, offset from @a _index_base. Empty if the values are not dense.
+  std::vector<Item *> _by_index;
+  intmax_t _index_base = 0;    ///< Value for the first element of @a _by_index.
+  intmax_t _value_min = 0;     ///< Minimum defined value.
+  intmax_t _value_max = 0;     ///< Maximum defined value.
   NameDefault _name_default;   ///< Name to return if no value not found.
   ValueDefault _value_default; ///< Value to return if name not found.
 };
 
+/** A constant bidirectional mapping between names and enumeration values.
+ *
+ * @tparam E Enumeration type.
+ * @tparam N Number of names.
+ * @tparam NOCASE Names are case insensitive.
+ *
+ * This is a @c Lexicon for a set of names fixed at compile time. All of the tables are built by the
+ * constructor, which is @c constexpr, so an instance can be a compile time constant with no run
+ * time construction. Use @c make_static_lexicon to avoid counting the names.
+ *
+ * @code
+ *   static constexpr auto Methods = swoc::make_static_lexicon<Method>(
+ *     {{Method::GET, "GET"}, {Method::POST, "POST"}, {Method::PUT, "PUT"}}).set_default(Method::NONE);
+ * @endcode
+ *
+ * Names are found with a minimal perfect hash, which is a single hash of the name, a table lookup,
+ * and a single name comparison. Values are found by index if they are contiguous, and by binary
+ * search if not.
+ *
+ * A value may appear more than once, the first name for a value is the primary name. Names must
+ * be unique, otherwise compilation fails. As with @c Lexicon, if there is no default for a missing
+ * name or value, an exception is thrown.
+ */
+template <typename E, size_t N, bool NOCASE = true> class StaticLexicon {
+  using self_type = StaticLexicon; ///< Self reference type.
+  static_assert(N > 0, "A StaticLexicon must have at least one name");
+
+public:
+  /// Initializer - a value and a name.
+  using Pair = std::pair<E, std::string_view>;
+
+  /// A value and its name.
+  struct Item {
+    E value{};             ///< Value.
+    std::string_view name; ///< Name.
+  };
+
+  /** Construct from pairs of values and names.
+   *
+   * @param items The values and names.
+   */
+  constexpr explicit StaticLexicon(Pair const (&items)[N]);
+
+  /** Get the name for a @a value.
+   *
+   * @param value Value to look up.
+   * @return The primary name for @a value.
+   */
+  constexpr std::string_view operator[](E value) const;
+
+  /** Get the value for a @a name.
+   *
+   * @param name Name to look up.
+   * @return The value for the @a name.
+   */
+  constexpr E operator[](std::string_view const &name) const;
+
+  /** Set the value to return for names that are not found.
+   *
+   * @param value Default value.
+   * @return @a this
+   */
+  constexpr self_type &set_default(E value);
+
+  /** Set the name to return for values that are not found.
+   *
+   * @param name Default name.
+   * @return @a this
+   */
+  constexpr self_type &set_default(std::string_view const &name);
+
+  /// @return The number of distinct values.
+  constexpr size_t count() const;
+
+  /// Iteration over the values and primary names, in value order.
+  constexpr Item const *begin() const;
+  /// Iteration end.
+  constexpr Item const *end() const;
+
+protected:
+  /// Hash of @a name, folded to lower case if case insensitive.
+  static constexpr uint64_t hash_of(std::string_view const &name);
+  /// Table slot for hash @a h with displacement @a d.
+  static constexpr size_t slot_of(uint64_t h, uint32_t d);
+  /// Compare names.
+  static constexpr bool equal(std::string_view const &lhs, std::string_view const &rhs);
+  /// @return The integral value of @a value.
+  static constexpr intmax_t ordinal(E value);
+
+  Item _slots[N];         ///< Names in hash slot order.
+  uint32_t _disp[N] = {}; ///< Displacement per hash bucket.
+  Item _by_value[N];      ///< Distinct values and primary names, sorted by value.
+  size_t _n_values = 0;   ///< Number of distinct values.
+  bool _dense_p    = false; ///< Values are contiguous.
+  E _value_default{};       ///< Value to return if name not found.
+  std::string_view _name_default; ///< Name to return if value not found.
+  bool _value_default_p = false;  ///< @a _value_default is set.
+  bool _name_default_p  = false;  ///< @a _name_default is set.
+};
+
+/** Construct a @c StaticLexicon.
+ *
+ * @tparam E Enumeration type.
+ * @tparam NOCASE Names are case insensitive.
+ * @param items Pairs of values and names.
+ * @return A lexicon for @a items.
+ */
+template <typename E, bool NOCASE = true, size_t N>
+constexpr StaticLexicon<E, N, NOCASE>
+make_static_lexicon(std::pair<E, std::string_view> const (&items)[N]) {
+  return StaticLexicon<E, N, NOCASE>{items};
+}
+
 // ==============
 // Implementation
 
@@ -450,9 +586,9 @@ Lexicon<E>::Item::ValueLinkage::key_of(Item *item) {
 }
 
 template <typename E>
-uint32_t
+uint64_t
 Lexicon<E>::Item::NameLinkage::hash_of(std::string_view s) {
-  return Hash32FNV1a().hash_immediate(transform_view_of(&toupper, s));
+  return Hash64Wy().hash_immediate_nocase(s);
 }
 
 template <typename E>
@@ -465,7 +601,7 @@ Lexicon<E>::Item::ValueLinkage::hash_of(E value) {
 template <typename E>
 bool
 Lexicon<E>::Item::NameLinkage::equal(std::string_view const &lhs, std::string_view const &rhs) {
-  return 0 == strcasecmp(lhs, rhs);
+  return strcaseeq(lhs, rhs);
 }
 
 template <typename E>
@@ -515,9 +651,58 @@ Lexicon<E>::localize(std::string_view const &name) {
   return span.view();
 }
 
+template <typename E>
+void
+Lexicon<E>::index_value(Item *item) {
+  if constexpr (INDEXABLE) {
+    auto v       = static_cast<intmax_t>(item->_value);
+    bool first_p = _by_value.count() == 1;
+    _value_min   = first_p ? v : std::min(_value_min, v);
+    _value_max   = first_p ? v : std::max(_value_max, v);
+
+    // Keep the index only if at least about half of the range has values. The span is zero only if
+    // it wrapped around, covering every value.
+    auto span = uintmax_t(_value_max) - uintmax_t(_value_min) + 1;
+    if (span == 0 || span > 2 * _by_value.count() + 16) {
+      _by_index.clear();
+      _by_index.shrink_to_fit();
+    } else if (_by_index.empty()) {
+      // Not yet indexed - build from the values.
+      _index_base = _value_min;
+      _by_index.assign(span, nullptr);
+      for (auto &spot : _by_value) {
+        _by_index[uintmax_t(static_cast<intmax_t>(spot._value)) - uintmax_t(_index_base)] = &spot;
+      }
+    } else {
+      if (v < _index_base) {
+        // Grow at the front with at least as much headroom as the current size, so that defining
+        // values in descending order is amortized constant time.
+        auto n = std::max<uintmax_t>(uintmax_t(_index_base) - uintmax_t(v), _by_index.size());
+        n      = std::min<uintmax_t>(n, uintmax_t(_index_base) - uintmax_t(std::numeric_limits<intmax_t>::min()));
+        _by_index.insert(_by_index.begin(), n, nullptr);
+        _index_base = intmax_t(uintmax_t(_index_base) - n);
+      } else if (auto n = uintmax_t(v) - uintmax_t(_index_base) + 1; n > _by_index.size()) {
+        _by_index.resize(n, nullptr); // resize grows the capacity geometrically.
+      }
+      _by_index[uintmax_t(v) - uintmax_t(_index_base)] = item;
+    }
+  }
+}
+
 template <typename E>
 std::string_view
 Lexicon<E>::operator[](E value) const {
+  if constexpr (INDEXABLE) {
+    if (!_by_index.empty()) {
+      // Unsigned, so values below the minimum are out of range as well.
+      if (auto idx = uintmax_t(static_cast<intmax_t>(value)) - uintmax_t(_index_base); idx < _by_index.size()) {
+        if (auto item = _by_index[idx]; item) {
+          return item->_name;
+        }
+      }
+      return std::visit(NameDefaultVisitor{value}, _name_default);
+    }
+  }
   auto spot = _by_value.find(value);
   if (spot != _by_value.end()) {
     return spot->_name;
@@ -550,6 +735,7 @@ Lexicon<E>::define(E value, const std::initializer_list<std::string_view> &names
     // Only put primary names in the value table.
     if (_by_value.find(value) == _by_value.end()) {
       _by_value.insert(i);
+      this->index_value(i);
     }
   }
   return *this;
@@ -688,6 +874,212 @@ Lexicon<E>::const_iterator::operator--(int) -> self_type {
   return tmp;
 }
 
+// -------
+// StaticLexicon
+
+template <typename E, size_t N, bool NOCASE>
+constexpr uint64_t
+StaticLexicon<E, N, NOCASE>::hash_of(std::string_view const &name) {
+  // FNV-1a, which is simple enough to be constexpr.
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (char c : name) {
+    if (NOCASE && 'A' <= c && c <= 'Z') {
+      c += 'a' - 'A';
+    }
+    h = (h ^ static_cast<uint8_t>(c)) * 0x100000001b3ull;
+  }
+  return h;
+}
+
+template <typename E, size_t N, bool NOCASE>
+constexpr size_t
+StaticLexicon<E, N, NOCASE>::slot_of(uint64_t h, uint32_t d) {
+  // Bucket keys share the low bits of the hash, so mix all of it.
+  h ^= d * 0x9e3779b97f4a7c15ull;
+  h  = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+  h  = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+  return (h ^ (h >> 31)) % N;
+}
+
+template <typename E, size_t N, bool NOCASE>
+constexpr bool
+StaticLexicon<E, N, NOCASE>::equal(std::string_view const &lhs, std::string_view const &rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    char l = lhs[i], r = rhs[i];
+    if (NOCASE) {
+      l = ('A' <= l && l <= 'Z') ? l + ('a' - 'A') : l;
+      r = ('A' <= r && r <= 'Z') ? r + ('a' - 'A') : r;
+    }
+    if (l != r) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename E, size_t N, bool NOCASE>
+constexpr intmax_t
+StaticLexicon<E, N, NOCASE>::ordinal(E value) {
+  return static_cast<intmax_t>(value);
+}
+
+template <typename E, size_t N, bool NOCASE> constexpr StaticLexicon<E, N, NOCASE>::StaticLexicon(Pair const (&items)[N]) {
+  uint64_t hashes[N]   = {};
+  size_t bucket_size[N] = {};
+  size_t max_size       = 0;
+  for (size_t i = 0; i < N; ++i) {
+    for (size_t k = 0; k < i; ++k) {
+      if (equal(items[i].second, items[k].second)) {
+        throw std::invalid_argument("Duplicate name in StaticLexicon");
+      }
+    }
+    hashes[i] = hash_of(items[i].second);
+    max_size  = std::max(max_size, ++bucket_size[hashes[i] % N]);
+  }
+
+  // Group the names by bucket - the names of bucket @c b are at <tt>members[first[b]]</tt>.
+  size_t first[N + 1] = {};
+  size_t members[N]   = {};
+  for (size_t b = 0; b < N; ++b) {
+    first[b + 1] = first[b] + bucket_size[b];
+  }
+  size_t fill[N] = {};
+  for (size_t i = 0; i < N; ++i) {
+    auto b                        = hashes[i] % N;
+    members[first[b] + fill[b]++] = i;
+  }
+
+  // Hash and displace - place the buckets largest first, finding for each a displacement that
+  // puts all of its names in distinct empty slots.
+  bool taken[N] = {};
+  for (size_t size = max_size; size > 0; --size) {
+    for (size_t b = 0; b < N; ++b) {
+      if (bucket_size[b] != size) {
+        continue;
+      }
+      for (uint32_t d = 0;; ++d) {
+        if (d > 1024 * N) {
+          throw std::invalid_argument("StaticLexicon perfect hash failed");
+        }
+        size_t slots[N] = {};
+        bool valid_p    = true;
+        for (size_t k = 0; valid_p && k < size; ++k) {
+          slots[k] = slot_of(hashes[members[first[b] + k]], d);
+          valid_p  = !taken[slots[k]];
+          for (size_t j = 0; valid_p && j < k; ++j) {
+            valid_p = slots[j] != slots[k];
+          }
+        }
+        if (valid_p) {
+          _disp[b] = d;
+          for (size_t k = 0; k < size; ++k) {
+            auto &item      = items[members[first[b] + k]];
+            taken[slots[k]]  = true;
+            _slots[slots[k]] = {item.first, item.second};
+          }
+          break;
+        }
+      }
+    }
+  }
+
+  // Primary names by value - insertion sort, skipping values already present.
+  for (auto const &[value, name] : items) {
+    size_t idx = 0;
+    while (idx < _n_values && ordinal(_by_value[idx].value) < ordinal(value)) {
+      ++idx;
+    }
+    if (idx < _n_values && _by_value[idx].value == value) {
+      continue;
+    }
+    for (size_t k = _n_values; k > idx; --k) {
+      _by_value[k] = _by_value[k - 1];
+    }
+    _by_value[idx] = {value, name};
+    ++_n_values;
+  }
+  _dense_p = size_t(ordinal(_by_value[_n_values - 1].value) - ordinal(_by_value[0].value)) == _n_values - 1;
+}
+
+template <typename E, size_t N, bool NOCASE>
+constexpr std::string_view
+StaticLexicon<E, N, NOCASE>::operator[](E value) const {
+  if (_dense_p) {
+    // Unsigned, so values before the first value are out of range as well.
+    if (auto idx = size_t(ordinal(value) - ordinal(_by_value[0].value)); idx < _n_values) {
+      return _by_value[idx].name;
+    }
+  } else {
+    size_t lo = 0, hi = _n_values;
+    while (lo < hi) {
+      auto mid = lo + (hi - lo) / 2;
+      if (ordinal(_by_value[mid].value) < ordinal(value)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    if (lo < _n_values && _by_value[lo].value == value) {
+      return _by_value[lo].name;
+    }
+  }
+  if (!_name_default_p) {
+    throw std::domain_error(detail::what("Lexicon: invalid enumeration value {}", static_cast<int>(value)).data());
+  }
+  return _name_default;
+}
+
+template <typename E, size_t N, bool NOCASE>
+constexpr E
+StaticLexicon<E, N, NOCASE>::operator[](std::string_view const &name) const {
+  auto h     = hash_of(name);
+  auto &item = _slots[slot_of(h, _disp[h % N])];
+  if (equal(item.name, name)) {
+    return item.value;
+  }
+  if (!_value_default_p) {
+    throw std::domain_error(detail::what("Lexicon: Unknown name \"{}\"", name).data());
+  }
+  return _value_default;
+}
+
+template <typename E, size_t N, bool NOCASE>
+constexpr auto
+StaticLexicon<E, N, NOCASE>::set_default(E value) -> self_type & {
+  _value_default   = value;
+  _value_default_p = true;
+  return *this;
+}
+
+template <typename E, size_t N, bool NOCASE>
+constexpr auto
+StaticLexicon<E, N, NOCASE>::set_default(std::string_view const &name) -> self_type & {
+  _name_default   = name;
+  _name_default_p = true;
+  return *this;
+}
+
+template <typename E, size_t N, bool NOCASE>
+constexpr size_t
+StaticLexicon<E, N, NOCASE>::count() const {
+  return _n_values;
+}
+
+template <typename E, size_t N, bool NOCASE>
+constexpr auto
+StaticLexicon<E, N, NOCASE>::begin() const -> Item const * {
+  return _by_value;
+}
+
+template <typename E, size_t N, bool NOCASE>
+constexpr auto
+StaticLexicon<E, N, NOCASE>::end() const -> Item const * {
+  return _by_value + _n_values;
+}
+
 template <typename E>
 BufferWriter &
 bwformat(BufferWriter &w, bwf::Spec const &spec, Lexicon<E> const &lex) {
@@ -0,0 +1,300 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Apache Software Foundation 2019
+/** @file
+
+  Thread safe intrusive hash map.
+
+  A set of @c IntrusiveHashMap instances, each with its own lock.
+*/
+
+#pragma once
+
+#include <array>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+
+#include "swoc/swoc_version.h"
+#include "swoc/IntrusiveHashMap.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+/** Thread safe intrusive hash map.
+ *
+ * @tparam H Hash map descriptor, the same as for @c IntrusiveHashMap.
+ * @tparam N Number of shards, which must be a power of 2.
+ *
+ * The elements are divided among @a N instances of @c IntrusiveHashMap, called shards, by hash
+ * value. Each shard has its own reader / writer lock, so that operations on different shards do not
+ * contend. Lookups take a shared lock, changes an exclusive lock.
+ *
+ * The shard is selected by the high bits of the hash value multiplied by a large odd constant
+ * (Fibonacci hashing). This depends on all of the bits of the hash value, so that weak hashes such
+ * as the identity hash for integers still spread across the shards, and it is not correlated with
+ * the bucket index in the shard.
+ *
+ * Iterators are not provided, because they would be invalidated by other threads. Instead elements
+ * can be accessed via a functor while the lock is held. Lookup that returns a pointer is provided
+ * but the client is responsible for making sure the element is not destroyed while in use.
+ *
+ * @code
+ *   swoc::ShardedHashMap<Descriptor> map;
+ *   map.insert(new Session{addr});
+ *   map.find(addr, [](Session & s) { s.touch(); });
+ * @endcode
+ */
+template <typename H, size_t N = 16> class ShardedHashMap {
+  using self_type = ShardedHashMap; ///< Self reference type.
+  static_assert(N > 0 && (N & (N - 1)) == 0, "The number of shards must be a power of 2");
+
+public:
+  /// Type of the shards.
+  using map_type = IntrusiveHashMap<H>;
+  /// Type of elements in the map.
+  using value_type = typename map_type::value_type;
+  /// Key type for the elements.
+  using key_type = typename map_type::key_type;
+  /// The numeric hash ID computed from a key.
+  using hash_id = typename map_type::hash_id;
+  /// Expansion policy for the shards.
+  using ExpansionPolicy = typename map_type::ExpansionPolicy;
+
+  /// Number of shards.
+  static constexpr size_t SHARD_COUNT = N;
+
+  /// Default constructor.
+  ShardedHashMap() = default;
+
+  /** Insert a value in to the map.
+   *
+   * @param v Value to insert.
+   *
+   * The @a value must @b NOT already be in a map of this type.
+   */
+  void insert(value_type *v);
+
+  /** Find an element with a key equal to @a key.
+   *
+   * @param key Key to find.
+   * @return The element, or @c nullptr if not found.
+   *
+   * The lock is released before returning, the client must assure the element is not destroyed
+   * by another thread while it is in use.
+   */
+  value_type *find(key_type key) const;
+
+  /** Apply a functor to the element with a key equal to @a key.
+   *
+   * @tparam F Functor type, compatible with <tt>void (value_type &)</tt>.
+   * @param key Key to find.
+   * @param f Functor to apply.
+   * @return @c true if an element was found, @c false if not.
+   *
+   * @a f is invoked with the shard lock held in shared mode. It must not modify the key and must
+   * not call other methods on this map.
+   */
+  template <typename F> bool find(key_type key, F &&f) const;
+
+  /** Remove the value @a v.
+   *
+   * @param v Value to remove.
+   * @return @c true if @a v was in the map and removed, @c false if not.
+   */
+  bool erase(value_type *v);
+
+  /** Remove an element with a key equal to @a key.
+   *
+   * @param key Key to find.
+   * @return The removed element, or @c nullptr if not found.
+   */
+  value_type *erase(key_type key);
+
+  /** Apply a functor to every element.
+   *
+   * @tparam F Functor type, compatible with <tt>void (value_type &)</tt> or <tt>void (value_type *)</tt>.
+   * @param f Functor to apply.
+   * @return @a this
+   *
+   * Each shard is locked in exclusive mode while @a f is applied to its elements. As with
+   * @c IntrusiveHashMap::apply this can be used to destroy the elements.
+   */
+  template <typename F> self_type &apply(F &&f);
+
+  /** Remove all elements.
+   *
+   * @return @a this
+   *
+   * The elements are not destroyed.
+   */
+  self_type &clear();
+
+  /// Number of elements in the map.
+  /// This is only an approximation if other threads are changing the map.
+  size_t count() const;
+
+  /// Set the expansion policy of every shard.
+  self_type &set_expansion_policy(ExpansionPolicy policy);
+
+  /// Set the expansion limit of every shard.
+  self_type &set_expansion_limit(size_t n);
+
+  /// Set the incremental expansion flag of every shard.
+  self_type &set_incremental_expansion(bool flag);
+
+  /// @return The index of the shard for hash value @a h.
+  static size_t shard_index(hash_id h);
+
+protected:
+  /// A lock and a map, aligned to avoid false sharing between shards.
+  struct alignas(64) Shard {
+    mutable std::shared_mutex _mutex; ///< Lock for @a _map.
+    map_type _map;                    ///< Elements in this shard.
+  };
+
+  std::array<Shard, N> _shards; ///< Shards.
+
+  /// @return The shard for @a key.
+  Shard &shard_for(key_type key);
+  /// @return The shard for @a key.
+  Shard const &shard_for(key_type key) const;
+};
+
+// --- Implementation ---
+
+template <typename H, size_t N>
+size_t
+ShardedHashMap<H, N>::shard_index(hash_id h) {
+  if constexpr (N == 1) {
+    return 0;
+  } else {
+    constexpr unsigned SHIFT = std::numeric_limits<uint64_t>::digits - __builtin_ctzll(N);
+    return size_t((uint64_t(std::make_unsigned_t<hash_id>(h)) * 0x9E3779B97F4A7C15ull) >> SHIFT);
+  }
+}
+
+template <typename H, size_t N>
+auto
+ShardedHashMap<H, N>::shard_for(key_type key) -> Shard & {
+  return _shards[shard_index(H::hash_of(key))];
+}
+
+template <typename H, size_t N>
+auto
+ShardedHashMap<H, N>::shard_for(key_type key) const -> Shard const & {
+  return _shards[shard_index(H::hash_of(key))];
+}
+
+template <typename H, size_t N>
+void
+ShardedHashMap<H, N>::insert(value_type *v) {
+  auto &shard = this->shard_for(H::key_of(v));
+  std::unique_lock lock(shard._mutex);
+  shard._map.insert(v);
+}
+
+template <typename H, size_t N>
+auto
+ShardedHashMap<H, N>::find(key_type key) const -> value_type * {
+  auto &shard = this->shard_for(key);
+  std::shared_lock lock(shard._mutex);
+  auto spot = shard._map.find(key);
+  return spot == shard._map.end() ? nullptr : const_cast<value_type *>(&*spot);
+}
+
+template <typename H, size_t N>
+template <typename F>
+bool
+ShardedHashMap<H, N>::find(key_type key, F &&f) const {
+  auto &shard = this->shard_for(key);
+  std::shared_lock lock(shard._mutex);
+  if (auto spot = shard._map.find(key); spot != shard._map.end()) {
+    f(const_cast<value_type &>(*spot));
+    return true;
+  }
+  return false;
+}
+
+template <typename H, size_t N>
+bool
+ShardedHashMap<H, N>::erase(value_type *v) {
+  auto &shard = this->shard_for(H::key_of(v));
+  std::unique_lock lock(shard._mutex);
+  return shard._map.erase(v);
+}
+
+template <typename H, size_t N>
+auto
+ShardedHashMap<H, N>::erase(key_type key) -> value_type * {
+  auto &shard = this->shard_for(key);
+  std::unique_lock lock(shard._mutex);
+  if (auto spot = shard._map.find(key); spot != shard._map.end()) {
+    value_type *zret = spot;
+    shard._map.erase(spot);
+    return zret;
+  }
+  return nullptr;
+}
+
+template <typename H, size_t N>
+template <typename F>
+auto
+ShardedHashMap<H, N>::apply(F &&f) -> self_type & {
+  for (auto &shard : _shards) {
+    std::unique_lock lock(shard._mutex);
+    shard._map.apply(f);
+  }
+  return *this;
+}
+
+template <typename H, size_t N>
+auto
+ShardedHashMap<H, N>::clear() -> self_type & {
+  for (auto &shard : _shards) {
+    std::unique_lock lock(shard._mutex);
+    shard._map.clear();
+  }
+  return *this;
+}
+
+template <typename H, size_t N>
+size_t
+ShardedHashMap<H, N>::count() const {
+  size_t zret = 0;
+  for (auto &shard : _shards) {
+    std::shared_lock lock(shard._mutex);
+    zret += shard._map.count();
+  }
+  return zret;
+}
+
+template <typename H, size_t N>
+auto
+ShardedHashMap<H, N>::set_expansion_policy(ExpansionPolicy policy) -> self_type & {
+  for (auto &shard : _shards) {
+    std::unique_lock lock(shard._mutex);
+    shard._map.set_expansion_policy(policy);
+  }
+  return *this;
+}
+
+template <typename H, size_t N>
+auto
+ShardedHashMap<H, N>::set_expansion_limit(size_t n) -> self_type & {
+  for (auto &shard : _shards) {
+    std::unique_lock lock(shard._mutex);
+    shard._map.set_expansion_limit(n);
+  }
+  return *this;
+}
+
+template <typename H, size_t N>
+auto
+ShardedHashMap<H, N>::set_incremental_expansion(bool flag) -> self_type & {
+  for (auto &shard : _shards) {
+    std::unique_lock lock(shard._mutex);
+    shard._map.set_incremental_expansion(flag);
+  }
+  return *this;
+}
+
+}} // namespace swoc::SWOC_VERSION_NS
@@ -0,0 +1,397 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+
+    Iteration over the tokens in a @c TextView.
+*/
+
+#pragma once
+
+#include <iterator>
+
+#include "swoc/swoc_version.h"
+#include "swoc/TextView.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+
+/** Split text in to tokens.
+ *
+ * This replaces the common loop of repeatedly calling @c TextView::take_prefix_at on a view. Each
+ * token is a view in to the original text, no memory is allocated. The tokenizer is a range and
+ * can be used in a range @c for loop.
+ *
+ * @code
+ *   for (auto line : swoc::TextTokenizer::lines(content)) {
+ *     for (auto field : swoc::TextTokenizer::quoted(line)) {
+ *       // ...
+ *     }
+ *   }
+ * @endcode
+ *
+ * The tokenizers are
+ *
+ * - @c lines - tokens are separated by newlines, and a trailing carriage return is dropped. A final
+ *   newline does not start another (empty) line.
+ * - @c fields - tokens are separated by a character, or one of a set of characters. Adjacent
+ *   delimiters are either empty tokens, or are treated as a single delimiter, which is appropriate
+ *   for whitespace separated fields.
+ * - @c quoted - comma separated values. A token that starts with a quote extends to the matching
+ *   quote and may contain delimiters. The quotes are removed from the token but escapes are not,
+ *   as that would require a copy.
+ *
+ * Leading tokens can be skipped without extracting them using @c skip. For lines and fields which
+ * are not collapsed this counts delimiters in blocks, which is much faster than extracting tokens.
+ */
+class TextTokenizer {
+  using self_type = TextTokenizer; ///< Self reference type.
+public:
+  class iterator;
+
+  /// Tokenizing style.
+  enum class Mode : uint8_t {
+    LINE,   ///< Newline separated.
+    FIELD,  ///< Separated by any character in a set.
+    QUOTED, ///< Separated by a character, tokens may be quoted.
+  };
+
+  /// Construct a tokenizer with no tokens.
+  TextTokenizer() = default;
+
+  /** Tokenize lines.
+   *
+   * @param text Source text.
+   * @return A tokenizer for the lines in @a text.
+   */
+  static self_type lines(TextView text);
+
+  /** Tokenize fields separated by any of a set of characters.
+   *
+   * @param text Source text.
+   * @param delimiters Field separators.
+   * @param collapse_p Treat a sequence of delimiters as a single delimiter.
+   * @return A tokenizer for the fields in @a text.
+   *
+   * If @a collapse_p is @c true then leading and trailing delimiters are ignored and there are no
+   * empty tokens.
+   */
+  static self_type fields(TextView text, CharSet const &delimiters, bool collapse_p = false);
+
+  /** Tokenize fields separated by a character.
+   *
+   * @param text Source text.
+   * @param delimiter Field separator.
+   * @param collapse_p Treat a sequence of delimiters as a single delimiter.
+   * @return A tokenizer for the fields in @a text.
+   */
+  static self_type fields(TextView text, char delimiter, bool collapse_p = false);
+
+  /** Tokenize comma separated values.
+   *
+   * @param text Source text.
+   * @param delimiter Field separator.
+   * @param quote Quote character.
+   * @param escape Escape character in quoted tokens.
+   * @return A tokenizer for the fields in @a text.
+   *
+   * In a quoted token the character after @a escape is not treated as a closing quote. If @a escape
+   * is the same as @a quote, then a doubled quote is an escaped quote. Text between the closing
+   * quote and the next delimiter is discarded.
+   */
+  static self_type quoted(TextView text, char delimiter = ',', char quote = '"', char escape = '"');
+
+  /// @return @c true if there are tokens remaining, @c false if not.
+  explicit operator bool() const;
+
+  /// @return @c true if there are no tokens remaining, @c false if there are.
+  bool empty() const;
+
+  /** Extract the next token.
+   *
+   * @return The next token, or an empty view if there are no tokens remaining.
+   */
+  TextView next();
+
+  /** Skip tokens.
+   *
+   * @param n Number of tokens to skip.
+   * @return @a this
+   *
+   * If there are fewer than @a n tokens remaining, all of them are skipped.
+   */
+  self_type &skip(size_t n);
+
+  /// @return The text not yet tokenized.
+  TextView remaining() const;
+
+  /// @return An iterator for the first remaining token.
+  iterator begin() const;
+  /// @return An iterator past the last token.
+  iterator end() const;
+
+protected:
+  TextView _text;      ///< Text not yet tokenized.
+  CharSet _delimiters; ///< Delimiters for @c Mode::FIELD.
+  Mode _mode        = Mode::LINE;
+  bool _more_p      = false; ///< There is another token, possibly empty.
+  bool _collapse_p  = false; ///< Adjacent delimiters are a single delimiter.
+  char _delimiter   = '\n';  ///< Delimiter for @c Mode::LINE and @c Mode::QUOTED.
+  char _quote       = '"';
+  char _escape      = '"';
+
+  /// Construct with common members.
+  TextTokenizer(TextView text, Mode mode);
+
+  /// Extract a quoted token.
+  TextView next_quoted();
+};
+
+/** Iterator over the tokens of a @c TextTokenizer.
+ *
+ * The iterator has its own copy of the tokenizer state and does not refer to the tokenizer.
+ */
+class TextTokenizer::iterator {
+  using self_type = iterator; ///< Self reference type.
+  friend TextTokenizer;
+
+public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type        = TextView;
+  using difference_type   = ptrdiff_t;
+  using pointer           = TextView const *;
+  using reference         = TextView const &;
+
+  /// Default constructor - equal to the end iterator.
+  iterator() = default;
+
+  /// @return The current token.
+  reference operator*() const;
+  /// @return A pointer to the current token.
+  pointer operator->() const;
+
+  /// Move to the next token.
+  self_type &operator++();
+  /// Move to the next token.
+  /// @return A copy of @a this before the move.
+  self_type operator++(int);
+
+  /// @return @c true if @a that is at the same token, @c false if not.
+  bool operator==(self_type const &that) const;
+  /// @return @c true if @a that is not at the same token, @c false if it is.
+  bool operator!=(self_type const &that) const;
+
+protected:
+  TextTokenizer _tokenizer; ///< Tokenizer for the tokens after @a _token.
+  TextView _token;          ///< Current token.
+  bool _valid_p = false;    ///< Not at the end.
+
+  /// Construct at the first remaining token of @a tokenizer.
+  explicit iterator(TextTokenizer const &tokenizer);
+};
+
+// --- Implementation ---
+
+inline TextTokenizer::TextTokenizer(TextView text, Mode mode) : _text(text), _mode(mode), _more_p(!text.empty()) {}
+
+inline auto
+TextTokenizer::lines(TextView text) -> self_type {
+  return {text, Mode::LINE};
+}
+
+inline auto
+TextTokenizer::fields(TextView text, CharSet const &delimiters, bool collapse_p) -> self_type {
+  self_type zret{text, Mode::FIELD};
+  zret._delimiters = delimiters;
+  zret._collapse_p = collapse_p;
+  if (collapse_p) {
+    zret._more_p = !zret._text.ltrim(delimiters).empty();
+  }
+  return zret;
+}
+
+inline auto
+TextTokenizer::fields(TextView text, char delimiter, bool collapse_p) -> self_type {
+  return fields(text, CharSet{}.add(delimiter), collapse_p);
+}
+
+inline auto
+TextTokenizer::quoted(TextView text, char delimiter, char quote, char escape) -> self_type {
+  self_type zret{text, Mode::QUOTED};
+  zret._delimiter = delimiter;
+  zret._quote     = quote;
+  zret._escape    = escape;
+  return zret;
+}
+
+inline TextTokenizer::operator bool() const {
+  return _more_p;
+}
+
+inline bool
+TextTokenizer::empty() const {
+  return !_more_p;
+}
+
+inline TextView
+TextTokenizer::remaining() const {
+  return _text;
+}
+
+inline TextView
+TextTokenizer::next() {
+  if (!_more_p) {
+    return {};
+  }
+
+  TextView zret;
+  switch (_mode) {
+  case Mode::LINE:
+    zret    = _text.take_prefix_at(_delimiter);
+    _more_p = !_text.empty();
+    if (zret.ends_with('\r')) {
+      zret.remove_suffix(1);
+    }
+    break;
+  case Mode::FIELD:
+    if (auto n = _text.find_first_of(_delimiters); n != TextView::npos) {
+      zret = _text.prefix(n);
+      _text.remove_prefix(n + 1);
+    } else {
+      zret = _text;
+      _text.clear();
+      _more_p = false;
+    }
+    if (_collapse_p) {
+      _more_p = !_text.ltrim(_delimiters).empty();
+    }
+    break;
+  case Mode::QUOTED:
+    zret = this->next_quoted();
+    break;
+  }
+  return zret;
+}
+
+inline TextView
+TextTokenizer::next_quoted() {
+  TextView zret;
+  TextView text  = _text;
+  bool quoted_p = text.starts_with(_quote);
+  if (quoted_p) {
+    // Find the closing quote, skipping escaped characters.
+    char stops[] = {_quote, _escape};
+    std::string_view stop_chars{stops, size_t(_quote == _escape ? 1 : 2)};
+    size_t idx = 1;
+    while (idx < text.size()) {
+      auto n = detail::find_first_of(text.data() + idx, text.size() - idx, stop_chars);
+      if (n == TextView::npos) {
+        idx = text.size(); // unterminated, take the rest.
+        break;
+      }
+      idx += n;
+      if (text[idx] == _escape && idx + 1 < text.size() && (_escape != _quote || text[idx + 1] == _quote)) {
+        idx += 2;
+      } else if (text[idx] == _quote) {
+        break;
+      } else {
+        ++idx;
+      }
+    }
+    zret = text.substr(1, idx - 1);
+    text.remove_prefix(idx + 1);
+  }
+
+  if (auto n = text.find(_delimiter); n != TextView::npos) {
+    if (!quoted_p) {
+      zret = text.prefix(n);
+    }
+    _text = text.substr(n + 1);
+  } else {
+    if (!quoted_p) {
+      zret = text;
+    }
+    _text.clear();
+    _more_p = false;
+  }
+  return zret;
+}
+
+inline auto
+TextTokenizer::skip(size_t n) -> self_type & {
+  if (n == 0 || !_more_p) {
+    return *this;
+  }
+
+  size_t idx = TextView::npos;
+  if (_mode == Mode::LINE) {
+    idx = detail::find_nth(_text.data(), _text.size(), _delimiter, n - 1);
+  } else if (_mode == Mode::FIELD && !_collapse_p) {
+    idx = detail::find_nth_of(_text.data(), _text.size(), _delimiters, n - 1);
+  } else {
+    while (n-- > 0 && _more_p) {
+      this->next();
+    }
+    return *this;
+  }
+
+  if (idx == TextView::npos) {
+    _text.clear();
+    _more_p = false;
+  } else {
+    _text.remove_prefix(idx + 1);
+    // A line is not started by a final newline.
+    _more_p = _mode != Mode::LINE || !_text.empty();
+  }
+  return *this;
+}
+
+inline auto
+TextTokenizer::begin() const -> iterator {
+  return iterator{*this};
+}
+
+inline auto
+TextTokenizer::end() const -> iterator {
+  return {};
+}
+
+inline TextTokenizer::iterator::iterator(TextTokenizer const &tokenizer) : _tokenizer(tokenizer), _valid_p(tokenizer._more_p) {
+  _token = _tokenizer.next();
+}
+
+inline auto
+TextTokenizer::iterator::operator*() const -> reference {
+  return _token;
+}
+
+inline auto
+TextTokenizer::iterator::operator->() const -> pointer {
+  return &_token;
+}
+
+inline auto
+TextTokenizer::iterator::operator++() -> self_type & {
+  _valid_p = _tokenizer._more_p;
+  _token   = _tokenizer.next();
+  return *this;
+}
+
+inline auto
+TextTokenizer::iterator::operator++(int) -> self_type {
+  self_type zret{*this};
+  ++*this;
+  return zret;
+}
+
+inline bool
+TextTokenizer::iterator::operator==(self_type const &that) const {
+  // The remaining text differs for every token, even empty ones, because a delimiter is consumed.
+  return _valid_p == that._valid_p &&
+         (!_valid_p || (_tokenizer._text.data() == that._tokenizer._text.data() && _tokenizer._more_p == that._tokenizer._more_p));
+}
+
+inline bool
+TextTokenizer::iterator::operator!=(self_type const &that) const {
+  return !(*this == that);
+}
+
+}} // namespace swoc::SWOC_VERSION_NS
@@ -12,12 +12,12 @@
 */
 
 #pragma once
-#include <bitset>
 #include <iosfwd>
 #include <memory.h>
 #include <string>
 #include <string_view>
 #include <limits>
+#include <algorithm>
 
 #include "swoc/swoc_version.h"
 #include "swoc/string_view_util.h"
@@ -26,6 +26,136 @@ namespace swoc { inline namespace SWOC_VERSION_NS {
 
 class TextView;
 
+/** A set of characters.
+ *
+ * This is a table with a bit for each of the 256 possible @c char values. It is intended to be
+ * constructed once, ideally at compile time, and then used repeatedly for delimiter operations on
+ * @c TextView instead of a string of delimiters which must be converted to a table on each use.
+ *
+ * @code
+ *   static constexpr swoc::CharSet SEPARATORS{",; \t"};
+ *   while (text) {
+ *     auto token = text.take_prefix_at(SEPARATORS);
+ *     // ...
+ *   }
+ * @endcode
+ *
+ * An instance is also a character predicate and can be used with the @c _if methods of @c TextView.
+ */
+class CharSet {
+  using self_type = CharSet; ///< Self reference type.
+public:
+  /// Construct an empty set.
+  constexpr CharSet() = default;
+
+  /** Construct the set of characters in @a chars.
+   *
+   * @param chars Characters in the set.
+   */
+  constexpr explicit CharSet(std::string_view const &chars);
+
+  /** Add @a c to the set.
+   *
+   * @param c Character to add.
+   * @return @a this
+   */
+  constexpr self_type &add(char c);
+
+  /** Add the characters in @a chars to the set.
+   *
+   * @param chars Characters to add.
+   * @return @a this
+   */
+  constexpr self_type &add(std::string_view const &chars);
+
+  /// @return @c true if @a c is in the set, @c false if not.
+  constexpr bool contains(char c) const;
+
+  /// Predicate support.
+  /// @return @c true if @a c is in the set, @c false if not.
+  constexpr bool operator()(char c) const;
+
+  /// Size of the membership table in bytes.
+  static constexpr size_t TABLE_SIZE = 32;
+
+  /** Access the membership table.
+   *
+   * @return A pointer to the @c TABLE_SIZE bytes of the table.
+   *
+   * The table is organized for vector nibble lookup. For a character with high nibble @c hi and
+   * low nibble @c lo the membership bit is bit <tt>hi % 8</tt> of byte <tt>16 * (hi / 8) + lo</tt>.
+   */
+  constexpr uint8_t const *table() const;
+
+protected:
+  /// Set membership bits.
+  uint8_t _table[TABLE_SIZE] = {};
+
+  /// @return The table index for @a c.
+  static constexpr unsigned index(char c);
+  /// @return The bit mask in the table byte for @a c.
+  static constexpr uint8_t mask(char c);
+};
+
+namespace detail {
+/** @defgroup TextViewScan Character search kernels.
+ *
+ * These search @a n characters starting at @a data and return the offset of the found character
+ * or @c TextView::npos if not found. Vector implementations are selected at run time according to
+ * the capabilities of the CPU.
+ * @{
+ */
+/// Find the first character in @a set.
+size_t find_first_of(char const *data, size_t n, CharSet const &set);
+/// Find the last character in @a set.
+size_t find_last_of(char const *data, size_t n, CharSet const &set);
+/// Find the first character not in @a set.
+size_t find_first_not_of(char const *data, size_t n, CharSet const &set);
+/// Find the last character not in @a set.
+size_t find_last_not_of(char const *data, size_t n, CharSet const &set);
+/// Find the first character in @a delimiters.
+size_t find_first_of(char const *data, size_t n, std::string_view const &delimiters);
+/// Find the last character in @a delimiters.
+size_t find_last_of(char const *data, size_t n, std::string_view const &delimiters);
+/// Find the last instance of @a c.
+size_t rfind(char const *data, size_t n, char c);
+/// Find the character in @a set after skipping @a k such characters.
+size_t find_nth_of(char const *data, size_t n, CharSet const &set, size_t k);
+/// Find the instance of @a c after skipping @a k instances.
+size_t find_nth(char const *data, size_t n, char c, size_t k);
+/** Compare @a n characters at @a lhs and @a rhs ignoring ASCII case.
+ *
+ * @return The difference of the lower cased characters at the first difference, 0 if none.
+ *
+ * This is @c strncasecmp in the "C" locale except that nul characters are compared like any other.
+ */
+int casecmp(char const *lhs, char const *rhs, size_t n);
+/// Find the first instance of the @a m characters at @a pattern, ignoring ASCII case.
+size_t find_nocase(char const *data, size_t n, char const *pattern, size_t m);
+
+/// Instruction sets for the search kernels.
+enum class ScanISA {
+  SCALAR, ///< Portable byte at a time.
+  SSE2,   ///< Single and double character searches, case folding.
+  SSSE3,  ///< Adds character set searches.
+  AVX2,   ///< 32 byte vectors.
+};
+
+/// @return The instruction set in use.
+ScanISA scan_isa();
+
+/** Set the instruction set for the search kernels.
+ *
+ * @param isa Instruction set to use.
+ * @return The instruction set actually used.
+ *
+ * If @a isa isn't supported by the CPU, the best supported instruction set is used instead. This is
+ * intended for testing and benchmarking.
+ */
+ScanISA scan_isa(ScanISA isa);
+/** @} */
+} // namespace detail
+
 /** A read only view of a contiguous piece of memory.
 
     A @c TextView does not own the memory to which it refers, it is simply a view of part of some
@@ -255,6 +385,24 @@ public:
   /// Get the offset of the last character for which @a pred is @c true.
   template <typename F> size_t rfind_if(F const &pred) const;
 
+  using super_type::find_first_of;
+  using super_type::find_last_of;
+
+  /// Get the offset of the first character that is in @a delimiters.
+  size_t find_first_of(CharSet const &delimiters) const;
+  /// Get the offset of the last character that is in @a delimiters.
+  size_t find_last_of(CharSet const &delimiters) const;
+
+  /** Find @a pattern ignoring case.
+   *
+   * @param pattern Text to find.
+   * @param pos Offset at which to start the search.
+   * @return The offset of the first instance of @a pattern at or after @a pos, or @c npos if not found.
+   *
+   * This is @c find except that ASCII letters match without regard to case.
+   */
+  size_t find_nocase(std::string_view const &pattern, size_t pos = 0) const noexcept;
+
   /** Remove bytes that match @a c from the start of the view.
    *
    * @return @a this
@@ -267,6 +415,12 @@ public:
    */
   self_type &ltrim(std::string_view const &delimiters);
 
+  /** Remove bytes from the start of the view that are in @a delimiters.
+   *
+   * @return @a this
+   */
+  self_type &ltrim(CharSet const &delimiters);
+
   /** Remove bytes from the start of the view that are in @a delimiters.
    *
    * @internal This is needed to avoid collisions with the templated predicate style.
@@ -292,6 +446,11 @@ public:
    */
   self_type &rtrim(std::string_view const &delimiters);
 
+  /** Remove bytes from the end of the view that are in @a delimiters.
+   * @return @a this
+   */
+  self_type &rtrim(CharSet const &delimiters);
+
   /** Remove bytes from the end of the view for which @a pred is @c true.
    *
    * @a pred must be a functor taking a @c char argument and returning @c bool.
@@ -311,6 +470,11 @@ public:
    */
   self_type &trim(std::string_view const &delimiters);
 
+  /** Remove bytes from the start and end of the view that are in @a delimiters.
+   * @return @a this
+   */
+  self_type &trim(CharSet const &delimiters);
+
   /** Remove bytes from the start and end of the view that are in @a delimiters.
       @internal This is needed to avoid collisions with the templated predicate style.
       @return @c *this
@@ -349,6 +513,9 @@ public:
    */
   self_type prefix_at(std::string_view const &delimiters) const;
 
+  /// @copydoc prefix_at(std::string_view const &) const
+  self_type prefix_at(CharSet const &delimiters) const;
+
   /** Get a view of a prefix bounded by a character predicate @a pred.
    *
    * @a pred must be a functor which takes a @c char argument and returns @c bool. Each character in
@@ -396,6 +563,9 @@ public:
    */
   self_type &remove_prefix_at(std::string_view const &delimiters);
 
+  /// @copydoc remove_prefix_at(std::string_view const &)
+  self_type &remove_prefix_at(CharSet const &delimiters);
+
   /** Remove the leading characters up to and including the character selected by @a pred.
    *
    * @tparam F Predicate function type.
@@ -446,6 +616,9 @@ public:
    */
   self_type split_prefix_at(std::string_view const &delimiters);
 
+  /// @copydoc split_prefix_at(std::string_view const &)
+  self_type split_prefix_at(CharSet const &delimiters);
+
   /** Remove and return a prefix bounded by the first character that satisfies @a pred.
    *
    * @tparam F Predicate functor type.
@@ -503,6 +676,9 @@ public:
    */
   self_type take_prefix_at(std::string_view const &delimiters);
 
+  /// @copydoc take_prefix_at(std::string_view const &)
+  self_type take_prefix_at(CharSet const &delimiters);
+
   /** Remove and return a prefix bounded by the first character that satisfies @a pred.
    *
    * @tparam F Predicate functor type.
@@ -556,6 +732,9 @@ public:
    */
   self_type suffix_at(std::string_view const &delimiters) const;
 
+  /// @copydoc suffix_at(std::string_view const &) const
+  self_type suffix_at(CharSet const &delimiters) const;
+
   /** Get a view of a suffix bounded by a character predicate @a pred.
    *
    * @a pred must be a functor which takes a @c char argument and returns @c bool. Each character in
@@ -590,6 +769,9 @@ public:
    */
   self_type &remove_suffix_at(std::string_view const &delimiters);
 
+  /// @copydoc remove_suffix_at(std::string_view const &)
+  self_type &remove_suffix_at(CharSet const &delimiters);
+
   /** Remove the trailing characters up to and including the character selected by @a pred.
    *
    * @tparam F Predicate function type.
@@ -638,6 +820,9 @@ public:
    */
   self_type split_suffix_at(std::string_view const &delimiters);
 
+  /// @copydoc split_suffix_at(std::string_view const &)
+  self_type split_suffix_at(CharSet const &delimiters);
+
   /** Remove and return a suffix bounded by the last character that satisfies @a pred.
    *
    * @tparam F Predicate functor type.
@@ -687,6 +872,9 @@ public:
    */
   self_type take_suffix_at(std::string_view const &delimiters);
 
+  /// @copydoc take_suffix_at(std::string_view const &)
+  self_type take_suffix_at(CharSet const &delimiters);
+
   /** Remove and return a suffix bounded by the last character that satisfies @a pred.
    *
    * @tparam F Predicate functor type.
@@ -864,10 +1052,6 @@ public:
   constexpr self_type suffix(int n) const noexcept;
   self_type split_suffix(int n);
   /// @endcond
-
-protected:
-  /// Initialize a bit mask to mark which characters are in this view.
-  static void init_delimiter_set(std::string_view const &delimiters, std::bitset<256> &set);
 };
 
 /// Internal table of digit values for characters.
@@ -898,6 +1082,99 @@ intmax_t svtoi(TextView src, TextView *parsed = nullptr, int base = 0);
 */
 uintmax_t svtou(TextView src, TextView *parsed = nullptr, int base = 0);
 
+namespace detail {
+/// Powers of 10 for scaling by the number of digits in a chunk.
+inline constexpr uint64_t SWAR_SCALE[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+/** Count leading decimal digits.
+ *
+ * @param chunk 8 characters, loaded little endian.
+ * @return The number of leading decimal digits in @a chunk.
+ */
+inline unsigned
+swar_digit_count(uint64_t chunk) {
+  // Non-zero for any byte that isn't '0'..'9'. A carry from adding 6 can only come from a non-digit
+  // and only affects later bytes, so the first non-zero byte is correct.
+  static constexpr uint64_t HI = 0xF0F0F0F0F0F0F0F0;
+  uint64_t t = ((chunk & HI) | (((chunk + 0x0606060606060606) & HI) >> 4)) ^ 0x3333333333333333;
+  return t ? __builtin_ctzll(t) / 8 : 8;
+}
+
+/** Compute the value of leading decimal digits.
+ *
+ * @param chunk 8 characters, loaded little endian.
+ * @param n Number of leading decimal digits in @a chunk, 1..8.
+ * @return The value of the first @a n characters in @a chunk.
+ */
+inline uint64_t
+swar_digit_value(uint64_t chunk, unsigned n) {
+  if (n < 8) { // move the digits to the end and fill with leading zeros.
+    chunk = (chunk << (8 * (8 - n))) | (0x3030303030303030 >> (8 * n));
+  }
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8); // pairs of digits.
+  // Combine the pairs in to 4 digit values, and those in to the final value.
+  return (((chunk & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) +
+          (((chunk >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >>
+         32;
+}
+
+/** Convert ASCII upper case letters to lower case.
+ *
+ * @param chunk 8 characters.
+ * @return @a chunk with the upper case letters in lower case.
+ */
+inline uint64_t
+swar_fold(uint64_t chunk) {
+  static constexpr uint64_t ONES = 0x0101010101010101;
+  // The high bit of each byte is set for 'A' or above, and for after 'Z', excluding non-ASCII.
+  uint64_t low = chunk & (0x7F * ONES);
+  uint64_t upper = (low + (0x80 - 'A') * ONES) & ~(low + (0x80 - 'Z' - 1) * ONES) & ~chunk & (0x80 * ONES);
+  return chunk | (upper >> 2);
+}
+
+/** Copy characters converting ASCII upper case letters to lower case.
+ *
+ * @param dst Destination.
+ * @param src Source.
+ * @param n Number of characters.
+ */
+inline void
+fold_copy(char *dst, char const *src, size_t n) {
+  for (; n >= sizeof(uint64_t); n -= sizeof(uint64_t), src += sizeof(uint64_t), dst += sizeof(uint64_t)) {
+    uint64_t chunk;
+    memcpy(&chunk, src, sizeof(chunk));
+    chunk = swar_fold(chunk);
+    memcpy(dst, &chunk, sizeof(chunk));
+  }
+  for (; n > 0; --n) {
+    char c = *src++;
+    *dst++ = ('A' <= c && c <= 'Z') ? c + ('a' - 'A') : c;
+  }
+}
+
+/** Update a hash with text converted to lower case.
+ *
+ * @tparam H Hash type, which must have an @c update method that takes a @c std::string_view.
+ * @param hasher Hash to update.
+ * @param data Input data.
+ * @return @a hasher
+ *
+ * The text is converted a chunk at a time with @c fold_copy, to avoid a per character transform.
+ */
+template <typename H>
+H &
+update_folded(H &hasher, std::string_view const &data) {
+  char chunk[64];
+  for (size_t idx = 0, n; idx < data.size(); idx += n) {
+    n = std::min(sizeof(chunk), data.size() - idx);
+    fold_copy(chunk, data.data() + idx, n);
+    hasher.update(std::string_view{chunk, n});
+  }
+  return hasher;
+}
+} // namespace detail
+
 /** Convert the text in @c src to an unsigned numeric value.
  *
  * @tparam N The radix (must be  1..36)
@@ -921,6 +1198,29 @@ svto_radix(swoc::TextView &src) {
   static constexpr auto OVERFLOW_LIMIT = MAX / RADIX;
   uintmax_t zret = 0;
   int8_t v;
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  // Decimal digits are done 8 at a time while there is enough text, which covers most or all of
+  // the digits of large values.
+  if constexpr (RADIX == 10 && sizeof(uintmax_t) == sizeof(uint64_t)) {
+    while (src.size() >= sizeof(uint64_t)) {
+      uint64_t chunk;
+      memcpy(&chunk, src.data(), sizeof(chunk));
+      auto n = detail::swar_digit_count(chunk);
+      if (n == 0) {
+        return zret;
+      }
+      src.remove_prefix(n);
+      uint64_t x = detail::swar_digit_value(chunk, n);
+      if (__builtin_mul_overflow(zret, detail::SWAR_SCALE[n], &zret) || __builtin_add_overflow(zret, x, &zret)) {
+        zret = MAX; // clamp, the loop below will consume any remaining digits.
+        break;
+      }
+      if (n < 8) {
+        return zret;
+      }
+    }
+  }
+#endif
   while (src.size() && (0 <= (v = swoc::svtoi_convert[uint8_t(*src)])) && v < RADIX) {
     // Tweaked for performance - need to check range after @a RADIX multiply.
     ++src; // Update view iff the character is parsed.
@@ -950,9 +1250,10 @@ svto_radix(swoc::TextView &&src) {
  * If @a parsed is not @a nullptr then the span of characters parsed is put there. This can be
  * used to check if the parse was scuccesful - on a failed parse, it will be empty.
  *
- * @note This should be within 1 epsilon of correct, although it doesn't guarantee picking
- * the closest epsilon. It's more than sufficient for use in configurations, but possibly
- * not for high precision work.
+ * The text is an optional sign, decimal digits with an optional decimal point, and an optional
+ * exponent. At least one digit is required. The exponent is parsed only if it has at least one
+ * digit. The result is correctly rounded, that is it is the closest @c double to the value of the
+ * text, the same as @c strtod.
  */
 double svtod(swoc::TextView text, swoc::TextView *parsed = nullptr);
 // ----------------------------------------------------------
@@ -971,13 +1272,54 @@ inline constexpr TextView::TextView(super_type const &that) noexcept : super_typ
 template <size_t N> constexpr TextView::TextView(const char (&s)[N]) noexcept : super_type(s, s[N - 1] ? N : N - 1) {}
 template <typename C, typename> constexpr TextView::TextView(C const &c) : super_type(c.data(), c.size()) {}
 
-inline void
-TextView::init_delimiter_set(std::string_view const &delimiters, std::bitset<256> &set) {
-  set.reset();
-  for (char c : delimiters)
-    set[static_cast<uint8_t>(c)] = true;
+// --- CharSet ---
+
+inline constexpr CharSet::CharSet(std::string_view const &chars) {
+  this->add(chars);
+}
+
+inline constexpr unsigned
+CharSet::index(char c) {
+  auto idx = static_cast<uint8_t>(c);
+  return (idx >> 7) * 16 + (idx & 0xF);
+}
+
+inline constexpr uint8_t
+CharSet::mask(char c) {
+  return 1 << ((static_cast<uint8_t>(c) >> 4) & 7);
 }
 
+inline constexpr auto
+CharSet::add(char c) -> self_type & {
+  _table[index(c)] |= mask(c);
+  return *this;
+}
+
+inline constexpr auto
+CharSet::add(std::string_view const &chars) -> self_type & {
+  for (char c : chars) {
+    this->add(c);
+  }
+  return *this;
+}
+
+inline constexpr bool
+CharSet::contains(char c) const {
+  return _table[index(c)] & mask(c);
+}
+
+inline constexpr bool
+CharSet::operator()(char c) const {
+  return this->contains(c);
+}
+
+inline constexpr uint8_t const *
+CharSet::table() const {
+  return _table;
+}
+
+// --- TextView ---
+
 inline TextView &
 TextView::clear() {
   new (this) self_type();
@@ -1102,6 +1444,15 @@ TextView::prefix_at(char c) const {
 
 inline TextView
 TextView::prefix_at(std::string_view const &delimiters) const {
+  self_type zret; // default to empty return.
+  if (auto n = detail::find_first_of(this->data(), this->size(), delimiters); n != npos) {
+    zret.assign(this->data(), n);
+  }
+  return zret;
+}
+
+inline TextView
+TextView::prefix_at(CharSet const &delimiters) const {
   self_type zret; // default to empty return.
   if (auto n = this->find_first_of(delimiters); n != npos) {
     zret.assign(this->data(), n);
@@ -1135,6 +1486,14 @@ TextView::remove_prefix_at(char c) {
 
 inline TextView &
 TextView::remove_prefix_at(std::string_view const &delimiters) {
+  if (auto n = detail::find_first_of(this->data(), this->size(), delimiters); n != npos) {
+    this->super_type::remove_prefix(n + 1);
+  }
+  return *this;
+}
+
+inline TextView &
+TextView::remove_prefix_at(CharSet const &delimiters) {
   if (auto n = this->find_first_of(delimiters); n != npos) {
     this->super_type::remove_prefix(n + 1);
   }
@@ -1172,6 +1531,11 @@ TextView::split_prefix_at(char c) {
 
 inline TextView
 TextView::split_prefix_at(std::string_view const &delimiters) {
+  return this->split_prefix(detail::find_first_of(this->data(), this->size(), delimiters));
+}
+
+inline TextView
+TextView::split_prefix_at(CharSet const &delimiters) {
   return this->split_prefix(this->find_first_of(delimiters));
 }
 
@@ -1196,6 +1560,11 @@ TextView::take_prefix_at(char c) {
 
 inline TextView
 TextView::take_prefix_at(std::string_view const &delimiters) {
+  return this->take_prefix(detail::find_first_of(this->data(), this->size(), delimiters));
+}
+
+inline TextView
+TextView::take_prefix_at(CharSet const &delimiters) {
   return this->take_prefix(this->find_first_of(delimiters));
 }
 
@@ -1219,7 +1588,7 @@ TextView::suffix(int n) const noexcept {
 inline TextView
 TextView::suffix_at(char c) const {
   self_type zret;
-  if (auto n = this->rfind(c); n != npos) {
+  if (auto n = detail::rfind(this->data(), this->size(), c); n != npos) {
     ++n;
     zret.assign(this->data() + n, this->size() - n);
   }
@@ -1228,6 +1597,16 @@ TextView::suffix_at(char c) const {
 
 inline TextView
 TextView::suffix_at(std::string_view const &delimiters) const {
+  self_type zret;
+  if (auto n = detail::find_last_of(this->data(), this->size(), delimiters); n != npos) {
+    ++n;
+    zret.assign(this->data() + n, this->size() - n);
+  }
+  return zret;
+}
+
+inline TextView
+TextView::suffix_at(CharSet const &delimiters) const {
   self_type zret;
   if (auto n = this->find_last_of(delimiters); n != npos) {
     ++n;
@@ -1255,7 +1634,7 @@ TextView::remove_suffix(size_t n) -> self_type & {
 
 inline TextView &
 TextView::remove_suffix_at(char c) {
-  if (auto n = this->rfind(c); n != npos) {
+  if (auto n = detail::rfind(this->data(), this->size(), c); n != npos) {
     this->remove_suffix(this->size() - n);
   }
   return *this;
@@ -1263,6 +1642,14 @@ TextView::remove_suffix_at(char c) {
 
 inline TextView &
 TextView::remove_suffix_at(std::string_view const &delimiters) {
+  if (auto n = detail::find_last_of(this->data(), this->size(), delimiters); n != npos) {
+    this->remove_suffix(this->size() - n);
+  }
+  return *this;
+}
+
+inline TextView &
+TextView::remove_suffix_at(CharSet const &delimiters) {
   if (auto n = this->find_last_of(delimiters); n != npos) {
     this->remove_suffix(this->size() - n);
   }
@@ -1294,12 +1681,18 @@ TextView::split_suffix(int n) -> self_type {
 
 inline TextView
 TextView::split_suffix_at(char c) {
-  auto idx = this->rfind(c);
+  auto idx = detail::rfind(this->data(), this->size(), c);
   return npos == idx ? self_type{} : this->split_suffix(this->size() - (idx + 1));
 }
 
 inline auto
 TextView::split_suffix_at(std::string_view const &delimiters) -> self_type {
+  auto idx = detail::find_last_of(this->data(), this->size(), delimiters);
+  return npos == idx ? self_type{} : this->split_suffix(this->size() - (idx + 1));
+}
+
+inline auto
+TextView::split_suffix_at(CharSet const &delimiters) -> self_type {
   auto idx = this->find_last_of(delimiters);
   return npos == idx ? self_type{} : this->split_suffix(this->size() - (idx + 1));
 }
@@ -1324,11 +1717,16 @@ TextView::take_suffix(int n) {
 
 inline TextView
 TextView::take_suffix_at(char c) {
-  return this->take_suffix(this->rfind(c));
+  return this->take_suffix(detail::rfind(this->data(), this->size(), c));
 }
 
 inline TextView
 TextView::take_suffix_at(std::string_view const &delimiters) {
+  return this->take_suffix(detail::find_last_of(this->data(), this->size(), delimiters));
+}
+
+inline TextView
+TextView::take_suffix_at(CharSet const &delimiters) {
   return this->take_suffix(this->find_last_of(delimiters));
 }
 
@@ -1338,6 +1736,25 @@ TextView::take_suffix_if(F const &pred) {
   return this->take_suffix_at(this->rfind_if(pred));
 }
 
+inline size_t
+TextView::find_first_of(CharSet const &delimiters) const {
+  return detail::find_first_of(this->data(), this->size(), delimiters);
+}
+
+inline size_t
+TextView::find_last_of(CharSet const &delimiters) const {
+  return detail::find_last_of(this->data(), this->size(), delimiters);
+}
+
+inline size_t
+TextView::find_nocase(std::string_view const &pattern, size_t pos) const noexcept {
+  if (pos > this->size()) {
+    return npos;
+  }
+  auto idx = detail::find_nocase(this->data() + pos, this->size() - pos, pattern.data(), pattern.size());
+  return idx == npos ? npos : idx + pos;
+}
+
 template <typename F>
 inline size_t
 TextView::find_if(F const &pred) const {
@@ -1376,15 +1793,13 @@ TextView::trim(char c) {
 
 inline TextView &
 TextView::ltrim(std::string_view const &delimiters) {
-  std::bitset<256> valid;
-  this->init_delimiter_set(delimiters, valid);
-  const char *spot;
-  const char *limit;
-
-  for (spot = this->data(), limit = this->data_end(); spot < limit && valid[static_cast<uint8_t>(*spot)]; ++spot)
-    ;
-  this->remove_prefix(spot - this->data());
+  return this->ltrim(CharSet{delimiters});
+}
 
+inline TextView &
+TextView::ltrim(CharSet const &delimiters) {
+  // If every character is a delimiter @c npos is returned, which clears the view.
+  this->remove_prefix(detail::find_first_not_of(this->data(), this->size(), delimiters));
   return *this;
 }
 
@@ -1395,37 +1810,24 @@ TextView::ltrim(const char *delimiters) {
 
 inline TextView &
 TextView::rtrim(std::string_view const &delimiters) {
-  std::bitset<256> valid;
-  this->init_delimiter_set(delimiters, valid);
-  const char *spot  = this->data_end();
-  const char *limit = this->data();
-
-  while (limit < spot-- && valid[static_cast<uint8_t>(*spot)])
-    ;
+  return this->rtrim(CharSet{delimiters});
+}
 
-  this->remove_suffix(this->data_end() - (spot + 1));
+inline TextView &
+TextView::rtrim(CharSet const &delimiters) {
+  auto idx = detail::find_last_not_of(this->data(), this->size(), delimiters);
+  this->remove_suffix(npos == idx ? this->size() : this->size() - (idx + 1));
   return *this;
 }
 
 inline TextView &
 TextView::trim(std::string_view const &delimiters) {
-  std::bitset<256> valid;
-  this->init_delimiter_set(delimiters, valid);
-  const char *spot;
-  const char *limit;
-
-  // Do this explicitly, so we don't have to initialize the character set twice.
-  for (spot = this->data(), limit = this->data_end(); spot < limit && valid[static_cast<uint8_t>(*spot)]; ++spot)
-    ;
-  this->remove_prefix(spot - this->data());
-
-  spot  = this->data_end();
-  limit = this->data();
-  while (limit < spot-- && valid[static_cast<uint8_t>(*spot)])
-    ;
-  this->remove_suffix(this->data_end() - (spot + 1));
+  return this->trim(CharSet{delimiters});
+}
 
-  return *this;
+inline TextView &
+TextView::trim(CharSet const &delimiters) {
+  return this->ltrim(delimiters).rtrim(delimiters);
 }
 
 inline TextView &
@@ -1500,7 +1902,7 @@ TextView::starts_with_nocase(char c) const noexcept {
 
 inline bool
 TextView::starts_with_nocase(std::string_view const &prefix) const noexcept {
-  return this->size() >= prefix.size() && 0 == ::strncasecmp(this->data(), prefix.data(), prefix.size());
+  return this->size() >= prefix.size() && 0 == detail::casecmp(this->data(), prefix.data(), prefix.size());
 }
 
 inline bool
@@ -1510,7 +1912,7 @@ TextView::ends_with(std::string_view const &suffix) const noexcept {
 
 inline bool
 TextView::ends_with_nocase(std::string_view const &suffix) const noexcept {
-  return this->size() >= suffix.size() && 0 == ::strncasecmp(this->data_end() - suffix.size(), suffix.data(), suffix.size());
+  return this->size() >= suffix.size() && 0 == detail::casecmp(this->data_end() - suffix.size(), suffix.data(), suffix.size());
 }
 
 inline bool
@@ -0,0 +1,260 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Apache Software Foundation 2019
+/** @file
+
+  Intrusive hierarchical timer wheel.
+
+  @note This is a header only library.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#include "swoc/swoc_version.h"
+#include "swoc/IntrusiveDList.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+/** Intrusive hierarchical timer wheel.
+
+    @tparam L Element access descriptor.
+    @tparam BITS Number of bits of the tick value for each level.
+    @tparam LEVELS Number of levels.
+
+    This tracks elements that expire at a specific tick. Time is measured in ticks, which are
+    unsigned 64 bit integers with client defined units. Adding and removing an element is constant
+    time, and no memory is allocated because the elements are kept in @c IntrusiveDList instances.
+
+    The descriptor @a L must have the members required by @c IntrusiveDList and
+
+    - @c key_of Return the expiration tick of an element.
+
+    The expiration tick of an element must not change while it is in the wheel. To change it, erase
+    the element, change the expiration, and insert it again.
+
+    There are @a LEVELS levels each with 2^BITS slots. An element is placed in the level of the most
+    significant @a BITS wide digit where its expiration tick differs from the current tick, in the
+    slot for that digit of the expiration tick. As the current tick advances the elements in a slot
+    move to lower levels when the current tick reaches that slot, and expire when they reach the
+    bottom level. Because the slot for an element depends only on its expiration tick and the current
+    tick, it can be found and the element removed without a search. Elements that expire beyond the
+    range of the levels are kept in a separate list which is checked each time the top level wraps.
+
+    @code
+      swoc::TimerWheel<Connection::Linkage> timers;
+      timers.insert(conn);
+      // Later, on every tick.
+      for (auto &conn : timers.advance(current_tick())) {
+        conn.timeout();
+      }
+    @endcode
+ */
+template <typename L, unsigned BITS = 8, unsigned LEVELS = 4> class TimerWheel {
+  using self_type = TimerWheel; ///< Self reference type.
+  static_assert(BITS > 0 && LEVELS > 0 && BITS * LEVELS <= 64, "The levels must fit in 64 bits");
+
+public:
+  /// List of elements.
+  using list_type = IntrusiveDList<L>;
+  /// Type of elements in the wheel.
+  using value_type = typename list_type::value_type;
+  /// Tick type.
+  using tick_type = uint64_t;
+
+  /// Number of slots in a level.
+  static constexpr size_t SLOTS = size_t(1) << BITS;
+  /// Number of bits of a tick covered by all of the levels.
+  static constexpr unsigned RANGE_BITS = BITS * LEVELS;
+
+  /** Constructor.
+
+      @param now Initial current tick.
+   */
+  explicit TimerWheel(tick_type now = 0);
+
+  /// No copying, elements can't be in two wheels.
+  TimerWheel(self_type const &) = delete;
+  /// No copying, elements can't be in two wheels.
+  self_type &operator=(self_type const &) = delete;
+
+  /** Add an element.
+
+      @param v Element to add.
+      @return @a this
+
+      If @a v has already expired it is returned by the next call to @c advance.
+   */
+  self_type &insert(value_type *v);
+
+  /** Remove an element.
+
+      @param v Element to remove.
+      @return @a this
+
+      @a v must be in the wheel.
+   */
+  self_type &erase(value_type *v);
+
+  /** Advance the current tick.
+
+      @param now The new current tick.
+      @return The elements that expire at or before @a now.
+
+      The elements are returned approximately in expiration order. If @a now is not after the
+      current tick, only elements that were inserted already expired are returned.
+
+      Ticks on which no elements move or expire are skipped, so the cost does not depend on how far
+      the current tick is advanced.
+   */
+  list_type advance(tick_type now);
+
+  /// @return The current tick.
+  tick_type now() const;
+
+  /// @return The number of elements in the wheel.
+  size_t count() const;
+
+protected:
+  tick_type _now;                               ///< Current tick.
+  size_t _count = 0;                            ///< Number of elements.
+  list_type _ready;                             ///< Elements that have expired.
+  list_type _overflow;                          ///< Elements beyond the range of the levels.
+  std::array<list_type, SLOTS * LEVELS> _slots; ///< Slots for all levels.
+
+  /// @return The list for an element that expires at @a tick.
+  list_type &slot_for(tick_type tick);
+
+  /// Move all elements in @a list to their current slots.
+  void cascade(list_type &list);
+
+  /** Find the next tick at which elements move or expire.
+   *
+   * @return The tick, or 0 if there are no elements in the slots or overflow.
+   *
+   * Nothing happens on the ticks in between, so @c advance can skip them.
+   */
+  tick_type next_event() const;
+
+  /// @return The digit of @a tick for @a level.
+  static size_t digit(tick_type tick, unsigned level);
+};
+
+// --- Implementation ---
+
+template <typename L, unsigned BITS, unsigned LEVELS> TimerWheel<L, BITS, LEVELS>::TimerWheel(tick_type now) : _now(now) {}
+
+template <typename L, unsigned BITS, unsigned LEVELS>
+size_t
+TimerWheel<L, BITS, LEVELS>::digit(tick_type tick, unsigned level) {
+  return (tick >> (level * BITS)) & (SLOTS - 1);
+}
+
+template <typename L, unsigned BITS, unsigned LEVELS>
+auto
+TimerWheel<L, BITS, LEVELS>::slot_for(tick_type tick) -> list_type & {
+  if (tick <= _now) {
+    return _ready;
+  }
+  tick_type diff = tick ^ _now;
+  if constexpr (RANGE_BITS < 64) {
+    if (diff >> RANGE_BITS) {
+      return _overflow;
+    }
+  }
+  unsigned level = (63 - __builtin_clzll(diff)) / BITS;
+  return _slots[level * SLOTS + digit(tick, level)];
+}
+
+template <typename L, unsigned BITS, unsigned LEVELS>
+void
+TimerWheel<L, BITS, LEVELS>::cascade(list_type &list) {
+  list_type tmp{std::move(list)};
+  while (value_type *v = tmp.take_head()) {
+    this->slot_for(L::key_of(v)).append(v);
+  }
+}
+
+template <typename L, unsigned BITS, unsigned LEVELS>
+auto
+TimerWheel<L, BITS, LEVELS>::next_event() const -> tick_type {
+  // Slots at or before the current digit of a level are empty, and every element in a level is
+  // due before any element in a higher level, so the first occupied slot is the next event.
+  for (unsigned level = 0; level < LEVELS; ++level) {
+    for (size_t idx = digit(_now, level) + 1; idx < SLOTS; ++idx) {
+      if (!_slots[level * SLOTS + idx].empty()) {
+        unsigned shift = (level + 1) * BITS; // clear this digit and the ones below it.
+        tick_type base = shift < 64 ? (_now >> shift) << shift : 0;
+        return base | (tick_type(idx) << (level * BITS));
+      }
+    }
+  }
+  // Only the overflow is left - go to the wrap where the earliest element comes in to range.
+  tick_type zret = 0;
+  if constexpr (RANGE_BITS < 64) {
+    for (auto const &item : _overflow) {
+      auto tick = (L::key_of(const_cast<value_type *>(&item)) >> RANGE_BITS) << RANGE_BITS;
+      if (zret == 0 || tick < zret) {
+        zret = tick;
+      }
+    }
+  }
+  return zret;
+}
+
+template <typename L, unsigned BITS, unsigned LEVELS>
+auto
+TimerWheel<L, BITS, LEVELS>::insert(value_type *v) -> self_type & {
+  this->slot_for(L::key_of(v)).append(v);
+  ++_count;
+  return *this;
+}
+
+template <typename L, unsigned BITS, unsigned LEVELS>
+auto
+TimerWheel<L, BITS, LEVELS>::erase(value_type *v) -> self_type & {
+  this->slot_for(L::key_of(v)).erase(v);
+  --_count;
+  return *this;
+}
+
+template <typename L, unsigned BITS, unsigned LEVELS>
+auto
+TimerWheel<L, BITS, LEVELS>::advance(tick_type now) -> list_type {
+  list_type zret{std::move(_ready)};
+  while (_now < now) {
+    tick_type t = this->next_event();
+    if (0 == t || t > now) {
+      _now = now;
+      break;
+    }
+    _now = t;
+    if constexpr (RANGE_BITS < 64) {
+      if (0 == (t & ((tick_type(1) << RANGE_BITS) - 1))) {
+        this->cascade(_overflow);
+      }
+    }
+    // A level is reached only when all the lower digits wrap to zero.
+    for (unsigned level = 1; level < LEVELS && 0 == (t & ((tick_type(1) << (level * BITS)) - 1)); ++level) {
+      this->cascade(_slots[level * SLOTS + digit(t, level)]);
+    }
+    zret.splice(zret.end(), _slots[digit(t, 0)]);
+    zret.splice(zret.end(), _ready);
+  }
+  _count -= zret.count();
+  return zret;
+}
+
+template <typename L, unsigned BITS, unsigned LEVELS>
+auto
+TimerWheel<L, BITS, LEVELS>::now() const -> tick_type {
+  return _now;
+}
+
+template <typename L, unsigned BITS, unsigned LEVELS>
+size_t
+TimerWheel<L, BITS, LEVELS>::count() const {
+  return _count;
+}
+
+}} // namespace swoc::SWOC_VERSION_NS
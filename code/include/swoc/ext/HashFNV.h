@@ -92,6 +92,23 @@ public:
    */
   template <typename X, typename V> value_type hash_immediate(TransformView<X, V> const &view);
 
+  /** Update the hash value ignoring ASCII case.
+   *
+   * @param data Input data to hash.
+   * @return @a this
+   *
+   * The result is the same as updating with @a data in lower case. This is faster than a
+   * @c TransformView because the case is converted 8 characters at a time.
+   */
+  self_type &update_nocase(std::string_view const &data);
+
+  /** Update and finalize ignoring ASCII case.
+   *
+   * @param data Input data to hash.
+   * @return The final hash value.
+   */
+  value_type hash_immediate_nocase(std::string_view const &data);
+
 private:
   value_type hval{INIT};
 };
@@ -158,6 +175,23 @@ public:
    */
   template <typename X, typename V> value_type hash_immediate(TransformView<X, V> const &view);
 
+  /** Update the hash value ignoring ASCII case.
+   *
+   * @param data Input data to hash.
+   * @return @a this
+   *
+   * The result is the same as updating with @a data in lower case. This is faster than a
+   * @c TransformView because the case is converted 8 characters at a time.
+   */
+  self_type &update_nocase(std::string_view const &data);
+
+  /** Update and finalize ignoring ASCII case.
+   *
+   * @param data Input data to hash.
+   * @return The final hash value.
+   */
+  value_type hash_immediate_nocase(std::string_view const &data);
+
 private:
   value_type hval{INIT};
 };
@@ -209,6 +243,16 @@ Hash32FNV1a::hash_immediate(std::string_view const &data) -> value_type {
   return this->update(data).final().get();
 }
 
+inline auto
+Hash32FNV1a::update_nocase(std::string_view const &data) -> self_type & {
+  return detail::update_folded(*this, data);
+}
+
+inline auto
+Hash32FNV1a::hash_immediate_nocase(std::string_view const &data) -> value_type {
+  return this->update_nocase(data).final().get();
+}
+
 // -- 64 --
 
 inline auto
@@ -253,4 +297,14 @@ Hash64FNV1a::hash_immediate(std::string_view const &data) -> value_type {
   return this->update(data).final().get();
 }
 
+inline auto
+Hash64FNV1a::update_nocase(std::string_view const &data) -> self_type & {
+  return detail::update_folded(*this, data);
+}
+
+inline auto
+Hash64FNV1a::hash_immediate_nocase(std::string_view const &data) -> value_type {
+  return this->update_nocase(data).final().get();
+}
+
 }} // namespace swoc::SWOC_VERSION_NS
@@ -0,0 +1,296 @@
+/** @file
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one or more contributor license agreements.
+  See the NOTICE file distributed with this work for additional information regarding copyright
+  ownership.  The ASF licenses this file to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance with the License.  You may obtain a
+  copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software distributed under the License
+  is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+  or implied. See the License for the specific language governing permissions and limitations under
+  the License.
+ */
+
+/*
+  https://github.com/wangyi-fudan/wyhash
+
+  wyhash "final4", which is public domain. This is an incremental version which produces the same
+  value as the one shot reference function with the default secret.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "swoc/TextView.h"
+
+namespace swoc { inline namespace SWOC_VERSION_NS {
+
+struct Hash64Wy {
+protected:
+  using self_type = Hash64Wy;
+  /// Size of the blocks mixed in the main loop.
+  static constexpr size_t BLOCK = 48;
+  /// Size of the tail look back.
+  static constexpr size_t BACK = 16;
+  /// Default secret.
+  static constexpr uint64_t SECRET[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull,
+                                         0x4d5a2da51de1aa47ull};
+
+public:
+  using value_type = uint64_t;
+
+  /** Construct with a seed.
+   *
+   * @param seed Seed value.
+   */
+  explicit Hash64Wy(uint64_t seed = 0);
+
+  /** Update the hash value.
+   *
+   * @param data Input data to hash.
+   * @return @a this
+   */
+  self_type &update(std::string_view const &data);
+
+  /** Finalize the hash value.
+   *
+   * @return @a this
+   *
+   * No more updates are valid after finalization.
+   */
+  self_type & final();
+
+  /// Return the hash value.
+  value_type get() const;
+
+  /// Re-initialize to default state.
+  self_type &clear();
+
+  /** Update with transformed data.
+   *
+   * @tparam X Transform functor.
+   * @tparam V Input data
+   * @param view transformed view
+   * @return @a this
+   *
+   * The hash is updated using the transformed data provided by @a view.
+   */
+  template <typename X, typename V> self_type &update(TransformView<X, V> view);
+
+  /** Update and finalize.
+   *
+   * @param data Input data to hash.
+   * @return The final hash value.
+   *
+   * Convenience method to compute a hash in one step.
+   */
+  value_type hash_immediate(std::string_view const &data);
+
+  /** Update and finalized with transformed data.
+   *
+   * @tparam X Transform functor.
+   * @tparam V Input data type.
+   * @param view transformed view
+   * @return @a this
+   *
+   * The hash is updated using the transformed data provided by @a view, then finalized.
+   */
+  template <typename X, typename V> value_type hash_immediate(TransformView<X, V> const &view);
+
+  /** Update the hash value ignoring ASCII case.
+   *
+   * @param data Input data to hash.
+   * @return @a this
+   *
+   * The result is the same as updating with @a data in lower case. This is faster than a
+   * @c TransformView because the case is converted 8 characters at a time.
+   */
+  self_type &update_nocase(std::string_view const &data);
+
+  /** Update and finalize ignoring ASCII case.
+   *
+   * @param data Input data to hash.
+   * @return The final hash value.
+   */
+  value_type hash_immediate_nocase(std::string_view const &data);
+
+protected:
+  uint64_t _init;         ///< Initial mixed seed.
+  uint64_t _seed;         ///< First lane, and the hash value after finalization.
+  uint64_t _see1;         ///< Second lane.
+  uint64_t _see2;         ///< Third lane.
+  uint64_t _len = 0;      ///< Total input length.
+  size_t _n     = 0;      ///< Pending bytes in @a _buf.
+  uint8_t _buf[BACK + BLOCK]; ///< Tail of the previous block followed by pending bytes.
+
+  static uint64_t mix(uint64_t a, uint64_t b);
+  static uint64_t r8(uint8_t const *p);
+  static uint64_t r4(uint8_t const *p);
+  /// Mix a block of @c BLOCK bytes.
+  void block(uint8_t const *p);
+};
+
+// ----------
+// Implementation
+
+inline Hash64Wy::Hash64Wy(uint64_t seed) : _init(seed ^ mix(seed ^ SECRET[0], SECRET[1])) {
+  this->clear();
+}
+
+inline auto
+Hash64Wy::clear() -> self_type & {
+  _seed = _see1 = _see2 = _init;
+  _len = _n = 0;
+  return *this;
+}
+
+inline uint64_t
+Hash64Wy::mix(uint64_t a, uint64_t b) {
+  __uint128_t r = a;
+  r *= b;
+  return uint64_t(r) ^ uint64_t(r >> 64);
+}
+
+inline uint64_t
+Hash64Wy::r8(uint8_t const *p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap64(v);
+#endif
+  return v;
+}
+
+inline uint64_t
+Hash64Wy::r4(uint8_t const *p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  v = __builtin_bswap32(v);
+#endif
+  return v;
+}
+
+inline void
+Hash64Wy::block(uint8_t const *p) {
+  _seed = mix(r8(p) ^ SECRET[1], r8(p + 8) ^ _seed);
+  _see1 = mix(r8(p + 16) ^ SECRET[2], r8(p + 24) ^ _see1);
+  _see2 = mix(r8(p + 32) ^ SECRET[3], r8(p + 40) ^ _see2);
+}
+
+inline auto
+Hash64Wy::update(std::string_view const &data) -> self_type & {
+  auto p     = reinterpret_cast<uint8_t const *>(data.data());
+  size_t n   = data.size();
+  _len      += n;
+  if (_n + n <= BLOCK) { // A block is mixed only if there is data after it.
+    memcpy(_buf + BACK + _n, p, n);
+    _n += n;
+    return *this;
+  }
+
+  if (_n) { // Complete and mix the pending block.
+    auto k = BLOCK - _n;
+    memcpy(_buf + BACK + _n, p, k);
+    p += k;
+    n -= k;
+    this->block(_buf + BACK);
+    memcpy(_buf, _buf + BLOCK, BACK);
+  }
+  if (n > BLOCK) {
+    do {
+      this->block(p);
+      p += BLOCK;
+      n -= BLOCK;
+    } while (n > BLOCK);
+    memcpy(_buf, p - BACK, BACK);
+  }
+  memcpy(_buf + BACK, p, n);
+  _n = n;
+  return *this;
+}
+
+template <typename X, typename V>
+auto
+Hash64Wy::update(TransformView<X, V> view) -> self_type & {
+  char chunk[BLOCK];
+  while (view) {
+    size_t n = 0;
+    for (; n < sizeof(chunk) && view; ++view) {
+      chunk[n++] = *view;
+    }
+    this->update(std::string_view{chunk, n});
+  }
+  return *this;
+}
+
+inline auto
+Hash64Wy::final() -> self_type & {
+  uint8_t const *p = _buf + BACK;
+  uint64_t seed    = _seed;
+  uint64_t a, b;
+  if (_len <= 16) {
+    if (_len >= 4) {
+      auto shift = (_len >> 3) << 2;
+      a          = (r4(p) << 32) | r4(p + shift);
+      b          = (r4(p + _len - 4) << 32) | r4(p + _len - 4 - shift);
+    } else if (_len > 0) {
+      a = (uint64_t(p[0]) << 16) | (uint64_t(p[_len >> 1]) << 8) | p[_len - 1];
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t i = _n;
+    if (_len > BLOCK) {
+      seed ^= _see1 ^ _see2;
+    }
+    for (; i > 16; i -= 16, p += 16) {
+      seed = mix(r8(p) ^ SECRET[1], r8(p + 8) ^ seed);
+    }
+    // This can reach back in to the previous block.
+    a = r8(p + i - 16);
+    b = r8(p + i - 8);
+  }
+  a ^= SECRET[1];
+  b ^= seed;
+  __uint128_t r = a;
+  r *= b;
+  _seed = mix(uint64_t(r) ^ SECRET[0] ^ _len, uint64_t(r >> 64) ^ SECRET[1]);
+  return *this;
+}
+
+inline auto
+Hash64Wy::get() const -> value_type {
+  return _seed;
+}
+
+template <typename X, typename V>
+auto
+Hash64Wy::hash_immediate(swoc::TransformView<X, V> const &view) -> value_type {
+  return this->update(view).final().get();
+}
+
+inline auto
+Hash64Wy::hash_immediate(std::string_view const &data) -> value_type {
+  return this->update(data).final().get();
+}
+
+inline auto
+Hash64Wy::update_nocase(std::string_view const &data) -> self_type & {
+  return detail::update_folded(*this, data);
+}
+
+inline auto
+Hash64Wy::hash_immediate_nocase(std::string_view const &data) -> value_type {
+  return this->update_nocase(data).final().get();
+}
+
+}} // namespace swoc::SWOC_VERSION_NS
@@ -24,9 +24,23 @@
  * -  0 if the views have identical content.
  *
  * If one view is the prefix of the other, the shorter view is less (first in the ordering).
+ *
+ * Case is ignored only for ASCII letters, as with @c strcasecmp in the "C" locale. Unlike @c
+ * strcasecmp nul characters are compared like any other character.
  */
 int strcasecmp(const std::string_view &lhs, const std::string_view &rhs);
 
+/** Compare views for equality, ignoring case.
+ *
+ * @param lhs input view
+ * @param rhs input view
+ * @return @c true if the views have the same content without regard to case, @c false if not.
+ *
+ * This is equivalent to <tt>0 == strcasecmp(lhs, rhs)</tt> but views of different sizes are
+ * rejected without comparing the content.
+ */
+bool strcaseeq(const std::string_view &lhs, const std::string_view &rhs);
+
 /** Compare views with ordering.
  *
  * @param lhs input view
@@ -13,6 +13,7 @@
 #include <string_view>
 #include <system_error>
 #include <chrono>
+#include <memory>
 
 #include "swoc/swoc_version.h"
 #include "swoc/TextView.h"
@@ -166,6 +167,83 @@ std::chrono::system_clock::time_point status_time(file_status const &fs);
  */
 std::string load(const path &p, std::error_code &ec);
 
+/** Read a file line by line, a block at a time.
+ *
+ * This reads the file in blocks in to an internal buffer and presents each line as a view in to
+ * that buffer, so that large files can be processed with bounded memory and without copying. The
+ * buffer is increased only if a single line is larger than the current buffer.
+ *
+ * @code
+ *   line_reader reader;
+ *   if (auto ec = reader.open(path) ; !ec) {
+ *     for (TextView line ; reader.next(line) ; ) {
+ *       // ... process line
+ *     }
+ *   }
+ * @endcode
+ *
+ * @note A line view is valid only until the next call to @c next.
+ */
+class line_reader {
+  using self_type = line_reader; ///< Self reference type.
+public:
+  /// Default size of the read buffer.
+  static constexpr size_t DEFAULT_BLOCK_SIZE = 1 << 16;
+
+  /** Construct with a read buffer of @a block_size bytes.
+   *
+   * @param block_size Initial size of the read buffer.
+   */
+  explicit line_reader(size_t block_size = DEFAULT_BLOCK_SIZE);
+
+  line_reader(self_type const &) = delete;
+  self_type &operator=(self_type const &) = delete;
+
+  /// Close the file if open.
+  ~line_reader();
+
+  /** Open the file at @a p for reading.
+   *
+   * @param p Path to the file.
+   * @return An error code for the open, which is zero on success.
+   *
+   * Any previously opened file is closed.
+   */
+  std::error_code open(path const &p);
+
+  /// Close the file.
+  void close();
+
+  /** Get the next line.
+   *
+   * @param line [out] The line, without the line terminator.
+   * @return @c true if a line was read, @c false if at the end of the file or an error occurred.
+   *
+   * A final line without a terminator is returned as a line.
+   */
+  bool next(TextView &line);
+
+  /// @return The line number of the last line returned by @c next.
+  size_t line_no() const;
+
+  /// @return The error code for the last read failure, zero if none.
+  std::error_code error() const;
+
+protected:
+  int _fd = -1;                 ///< File descriptor.
+  std::unique_ptr<char[]> _buf; ///< Read buffer.
+  size_t _capacity = 0;         ///< Size of @a _buf.
+  TextView _data;               ///< Unconsumed data in @a _buf.
+  size_t _scanned = 0;          ///< Bytes of @a _data known to not contain a line terminator.
+  size_t _line_no = 0;          ///< Current line number.
+  bool _eof_p     = false;      ///< End of file reached.
+  std::error_code _ec;          ///< Read error.
+
+  /// Read more data in to the buffer.
+  /// @return @c true if data was read, @c false if at end of file or error.
+  bool fill();
+};
+
 /* ------------------------------------------------------------------- */
 
 inline path::path(char const *src) : _path(src) {}
@@ -249,6 +327,22 @@ operator/(path &&lhs, std::string_view rhs) {
   return path(std::move(lhs)) /= rhs;
 }
 
+inline line_reader::line_reader(size_t block_size) : _buf(new char[block_size]), _capacity(block_size) {}
+
+inline line_reader::~line_reader() {
+  this->close();
+}
+
+inline size_t
+line_reader::line_no() const {
+  return _line_no;
+}
+
+inline std::error_code
+line_reader::error() const {
+  return _ec;
+}
+
 } // namespace file
 
 class BufferWriter;
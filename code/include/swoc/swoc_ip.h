@@ -10,8 +10,10 @@
 #include <climits>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <optional>
 #include <string_view>
 #include <variant>
+#include <vector>
 
 #include "swoc/swoc_version.h"
 #include "swoc/TextView.h"
@@ -353,6 +355,7 @@ class IP6Addr {
   using self_type = IP6Addr; ///< Self reference type.
 
   friend class IP6Range;
+  friend class IPRange;
   friend class IPMask;
 
 public:
@@ -920,6 +923,20 @@ public:
    * @endcode
    */
   NetSource networks() const;
+
+  /// Maximum number of networks needed to cover any IPv4 range.
+  static constexpr size_t MAX_NETWORKS = 2 * IP4Addr::WIDTH - 2;
+
+  /** Compute the networks covering @a this range.
+   *
+   * @param nets Output buffer for the networks.
+   * @return The number of networks in the minimal cover of @a this range.
+   *
+   * The networks are computed directly from the range boundaries in a single pass and written to
+   * @a nets in increasing order. If the return value is larger than the size of @a nets, only
+   * the leading networks that fit were written. A buffer of @c MAX_NETWORKS is always sufficient.
+   */
+  size_t networks(MemSpan<IP4Net> nets) const;
 };
 
 /** Network generator class.
@@ -979,11 +996,8 @@ protected:
   IP4Addr _mask{~static_cast<in_addr_t>(0)};
   IPMask::raw_type _cidr = IP4Addr::WIDTH; ///< Current CIDR value.
 
-  void search_wider();
-
-  void search_narrower();
-
-  bool is_valid(IP4Addr mask) const;
+  /// Set the mask to that of the largest network at the start of the remaining range.
+  void set_mask();
 };
 
 class IP6Range : public DiscreteRange<IP6Addr> {
@@ -1055,6 +1069,20 @@ public:
    * @endcode
    */
   NetSource networks() const;
+
+  /// Maximum number of networks needed to cover any IPv6 range.
+  static constexpr size_t MAX_NETWORKS = 2 * IP6Addr::WIDTH - 2;
+
+  /** Compute the networks covering @a this range.
+   *
+   * @param nets Output buffer for the networks.
+   * @return The number of networks in the minimal cover of @a this range.
+   *
+   * The networks are computed directly from the range boundaries in a single pass and written to
+   * @a nets in increasing order. If the return value is larger than the size of @a nets, only
+   * the leading networks that fit were written. A buffer of @c MAX_NETWORKS is always sufficient.
+   */
+  size_t networks(MemSpan<IP6Net> nets) const;
 };
 
 /** Network generator class.
@@ -1111,11 +1139,8 @@ protected:
   IP6Range _range;              ///< Remaining range.
   IPMask _mask{IP6Addr::WIDTH}; ///< Current CIDR value.
 
-  void search_wider();
-
-  void search_narrower();
-
-  bool is_valid(IPMask const &mask);
+  /// Set the mask to that of the largest network at the start of the remaining range.
+  void set_mask();
 };
 
 class IPRange {
@@ -1220,6 +1245,19 @@ public:
    */
   NetSource networks() const;
 
+  /// Maximum number of networks needed to cover any range.
+  static constexpr size_t MAX_NETWORKS = IP6Range::MAX_NETWORKS;
+
+  /** Compute the networks covering @a this range.
+   *
+   * @param nets Output buffer for the networks.
+   * @return The number of networks in the minimal cover of @a this range.
+   *
+   * @see IP4Range::networks(MemSpan<IP4Net>)
+   * @see IP6Range::networks(MemSpan<IP6Net>)
+   */
+  size_t networks(MemSpan<IPNet> nets) const;
+
 protected:
   /** Range container.
    *
@@ -1627,6 +1665,40 @@ public:
   /// Remove all ranges.
   void clear();
 
+  /** A change to the payload of a range of addresses.
+   *
+   * A payload that is not present means the addresses are not in the space.
+   */
+  struct Change {
+    IPRange _range;                ///< Addresses changed.
+    std::optional<PAYLOAD> _prior; ///< Payload in the original space.
+    std::optional<PAYLOAD> _after; ///< Payload in the updated space.
+  };
+
+  /// A sequence of changes, ordered by address.
+  using Diff = std::vector<Change>;
+
+  /** Compute the differences between two spaces.
+   *
+   * @param that The updated space.
+   * @return The changes needed to transform @a this in to @a that.
+   *
+   * Both spaces are walked in order in lockstep and there is a change for each maximal range of
+   * addresses for which the pair of payloads is constant and differs between the spaces.
+   */
+  Diff diff(self_type const &that) const;
+
+  /** Apply changes.
+   *
+   * @param diff The changes.
+   * @return @a this
+   *
+   * For each change the range is marked with the updated payload or erased if the addresses are
+   * not in the updated space. If @a diff was computed from this space, the result is equal to
+   * the updated space.
+   */
+  self_type &apply(Diff const &diff);
+
   /** Constant iterator.
    * THe value type is a tuple of the IP address range and the @a PAYLOAD. Both are constant.
    *
@@ -1700,6 +1772,10 @@ public:
     /// Inequality
     bool operator!=(self_type const &that) const;
 
+    /// @return The hit count for the current range.
+    /// @see IPSpace::set_hit_counting
+    uint64_t hits() const;
+
   protected:
     // These are stored non-const to make implementing @c iterator easier. The containing class provides the
     // required @c const protection. This is basic a tuple of iterators - for forward iteration if
@@ -1814,7 +1890,7 @@ public:
   iterator
   find(IP4Addr const &addr) {
     auto spot = _ip4.find(addr);
-    return spot == _ip4.end() ? this->end() : iterator{_ip4.find(addr), _ip6.begin()};
+    return spot == _ip4.end() ? this->end() : iterator{spot, _ip6.begin()};
   }
 
   /** Find the payload for an @a addr.
@@ -1827,6 +1903,132 @@ public:
     return {_ip4.end(), _ip6.find(addr)};
   }
 
+  /** Enable or disable hit counting.
+   *
+   * @param flag @c true to enable, @c false to disable.
+   * @return @a this
+   *
+   * If enabled, @c find increments a counter in the range found. This is done with relaxed atomics
+   * so concurrent lookups are safe. When disabled the cost is a single flag check per @c find.
+   *
+   * @see hits
+   */
+  self_type &set_hit_counting(bool flag);
+
+  /// @return @c true if hit counting is enabled for both IPv4 and IPv6.
+  bool
+  is_hit_counting() const {
+    return _ip4.is_hit_counting() && _ip6.is_hit_counting();
+  }
+
+  /// Set the hit count of every range to zero.
+  void reset_hits();
+
+  /** Hit count iterator.
+   *
+   * The value type is a tuple of the range, the payload, and the hit count. The count is loaded
+   * when the iterator is dereferenced.
+   */
+  class hit_iterator : public const_iterator {
+    using self_type  = hit_iterator;
+    using super_type = const_iterator;
+
+    friend class IPSpace;
+
+  public:
+    /// Value type of iteration.
+    using value_type = std::tuple<IPRange const, PAYLOAD const &, uint64_t>;
+    using pointer    = value_type *;
+    using reference  = value_type &;
+
+    /// Default constructor.
+    hit_iterator() = default;
+
+    /// Pre-increment.
+    /// Move to the next element in the list.
+    /// @return The iterator.
+    self_type &
+    operator++() {
+      this->super_type::operator++();
+      return *this;
+    }
+
+    /// Pre-decrement.
+    /// Move to the previous element in the list.
+    /// @return The iterator.
+    self_type &
+    operator--() {
+      this->super_type::operator--();
+      return *this;
+    }
+
+    /// Post-increment.
+    /// Move to the next element in the list.
+    /// @return The iterator value before the increment.
+    self_type
+    operator++(int) {
+      self_type zret{*this};
+      ++*this;
+      return zret;
+    }
+
+    /// Post-decrement.
+    /// Move to the previous element in the list.
+    /// @return The iterator value before the decrement.
+    self_type
+    operator--(int) {
+      self_type zret{*this};
+      --*this;
+      return zret;
+    }
+
+    /// Dereference.
+    /// @return A snapshot of the range, payload, and hit count.
+    value_type
+    operator*() const {
+      return {std::get<0>(this->_value), std::get<1>(this->_value), this->hits()};
+    }
+
+    /// The value is a snapshot and there is nothing to point at, use @c operator* instead.
+    value_type const *operator->() const = delete;
+
+  protected:
+    /// Construct from an iterator.
+    hit_iterator(super_type const &that) : super_type(that) {}
+  };
+
+  /// A view of the hit counts of a space, for use in range @c for loops.
+  class HitView {
+    friend class IPSpace;
+
+  public:
+    /// @return Iterator for the first range.
+    hit_iterator
+    begin() const {
+      return _begin;
+    }
+
+    /// @return Iterator past the last range.
+    hit_iterator
+    end() const {
+      return _end;
+    }
+
+  protected:
+    hit_iterator _begin; ///< First range.
+    hit_iterator _end;   ///< Past last range.
+  };
+
+  /** Iterate over the ranges with hit counts.
+   *
+   * @return A view of the space with hit counts.
+   *
+   * @code
+   *   for ( auto && [ range, payload, hits ] : space.hits() ) { ... }
+   * @endcode
+   */
+  HitView hits() const;
+
   /// @return A constant iterator to the first element.
   const_iterator begin() const;
 
@@ -1868,6 +2070,10 @@ public:
 protected:
   IP4Space _ip4; ///< Sub-space containing IPv4 ranges.
   IP6Space _ip6; ///< sub-space containing IPv6 ranges.
+
+  /// Append the differences between family sub-spaces @a lhs and @a rhs to @a changes.
+  template <typename METRIC>
+  static void diff(DiscreteSpace<METRIC, PAYLOAD> &lhs, DiscreteSpace<METRIC, PAYLOAD> &rhs, Diff &changes);
 };
 
 template <typename PAYLOAD>
@@ -1981,6 +2187,12 @@ IPSpace<PAYLOAD>::const_iterator::operator!=(self_type const &that) const {
   return _iter_4 != that._iter_4 || _iter_6 != that._iter_6;
 }
 
+template <typename PAYLOAD>
+uint64_t
+IPSpace<PAYLOAD>::const_iterator::hits() const {
+  return _iter_4.has_next() ? _iter_4->hits() : _iter_6.has_next() ? _iter_6->hits() : 0;
+}
+
 template <typename PAYLOAD> IPSpace<PAYLOAD>::iterator::iterator(self_type const &that) {
   *this = that;
 }
@@ -2953,11 +3165,6 @@ operator==(IP6Net const &lhs, IPNet const &rhs) {
 
 // +++ Range -> Network classes +++
 
-inline bool
-IP4Range::NetSource::is_valid(swoc::IP4Addr mask) const {
-  return ((mask._addr & _range._min._addr) == _range._min._addr) && ((_range._min._addr | ~mask._addr) <= _range._max._addr);
-}
-
 inline IP4Net
 IP4Range::NetSource::operator*() const {
   return IP4Net{_range.min(), IPMask{_cidr}};
@@ -3028,11 +3235,6 @@ IP6Range::NetSource::operator->() -> self_type * {
   return this;
 }
 
-inline bool
-IP6Range::NetSource::is_valid(IPMask const &mask) {
-  return ((_range.min() & mask) == _range.min()) && ((_range.min() | mask) <= _range.max());
-}
-
 inline bool
 IP6Range::NetSource::operator==(IP6Range::NetSource::self_type const &that) const {
   return ((_mask == that._mask) && (_range == that._range)) || (_range.empty() && that._range.empty());
@@ -3203,6 +3405,30 @@ IPSpace<PAYLOAD>::clear() {
   _ip6.clear();
 }
 
+template <typename PAYLOAD>
+auto
+IPSpace<PAYLOAD>::set_hit_counting(bool flag) -> self_type & {
+  _ip4.set_hit_counting(flag);
+  _ip6.set_hit_counting(flag);
+  return *this;
+}
+
+template <typename PAYLOAD>
+void
+IPSpace<PAYLOAD>::reset_hits() {
+  _ip4.reset_hits();
+  _ip6.reset_hits();
+}
+
+template <typename PAYLOAD>
+auto
+IPSpace<PAYLOAD>::hits() const -> HitView {
+  HitView zret;
+  zret._begin = hit_iterator{this->begin()};
+  zret._end   = hit_iterator{this->end()};
+  return zret;
+}
+
 template <typename PAYLOAD>
 auto
 IPSpace<PAYLOAD>::begin() const -> const_iterator {
@@ -3255,6 +3481,108 @@ IPSpace<PAYLOAD>::end() -> iterator {
   return iterator{_ip4.end(), _ip6.end()};
 }
 
+template <typename PAYLOAD>
+auto
+IPSpace<PAYLOAD>::diff(self_type const &that) const -> Diff {
+  Diff zret;
+  auto nc_this = const_cast<self_type *>(this);
+  auto nc_that = const_cast<self_type *>(&that);
+  diff(nc_this->_ip4, nc_that->_ip4, zret);
+  diff(nc_this->_ip6, nc_that->_ip6, zret);
+  return zret;
+}
+
+template <typename PAYLOAD>
+template <typename METRIC>
+void
+IPSpace<PAYLOAD>::diff(DiscreteSpace<METRIC, PAYLOAD> &lhs, DiscreteSpace<METRIC, PAYLOAD> &rhs, Diff &changes) {
+  auto lspot = lhs.begin();
+  auto lend  = lhs.end();
+  auto rspot = rhs.begin();
+  auto rend  = rhs.end();
+  METRIC pos;        // Values before this have been processed.
+  bool pos_p = false; // @a pos is valid - no values have been processed if not.
+
+  // Pending change - held back so that subsequent changes can be coalesced in to it.
+  bool pending_p = false;
+  DiscreteRange<METRIC> pending;
+  std::optional<PAYLOAD> prior;
+  std::optional<PAYLOAD> after;
+
+  auto flush = [&]() -> void {
+    if (pending_p) {
+      changes.push_back(Change{IPRange{pending.min(), pending.max()}, std::move(prior), std::move(after)});
+      pending_p = false;
+    }
+  };
+
+  while (lspot != lend || rspot != rend) {
+    bool l_p = lspot != lend;
+    bool r_p = rspot != rend;
+    // Effective minimum of the current nodes, clipped to values not yet processed.
+    METRIC lmin = l_p ? ((pos_p && lspot->min() < pos) ? pos : lspot->min()) : METRIC{};
+    METRIC rmin = r_p ? ((pos_p && rspot->min() < pos) ? pos : rspot->min()) : METRIC{};
+    METRIC min, max;
+    PAYLOAD const *lp = nullptr; // Payload in @a lhs for [min, max]
+    PAYLOAD const *rp = nullptr; // Payload in @a rhs for [min, max]
+
+    if (l_p && (!r_p || lmin < rmin)) {
+      min = lmin;
+      max = (r_p && rmin <= lspot->max()) ? --METRIC{rmin} : lspot->max();
+      lp  = &lspot->payload();
+    } else if (r_p && (!l_p || rmin < lmin)) {
+      min = rmin;
+      max = (l_p && lmin <= rspot->max()) ? --METRIC{lmin} : rspot->max();
+      rp  = &rspot->payload();
+    } else { // same start
+      min = lmin;
+      max = lspot->max() < rspot->max() ? lspot->max() : rspot->max();
+      lp  = &lspot->payload();
+      rp  = &rspot->payload();
+    }
+
+    if (!(lp && rp && *lp == *rp)) {
+      // Extend the pending change if adjacent with the same payloads.
+      if (pending_p && ++METRIC{pending.max()} == min && prior.has_value() == (lp != nullptr) &&
+          after.has_value() == (rp != nullptr) && (!lp || *prior == *lp) && (!rp || *after == *rp)) {
+        pending.assign_max(max);
+      } else {
+        flush();
+        pending_p = true;
+        pending.assign(min, max);
+        prior = lp ? std::optional<PAYLOAD>{*lp} : std::nullopt;
+        after = rp ? std::optional<PAYLOAD>{*rp} : std::nullopt;
+      }
+    }
+
+    if (l_p && lspot->max() == max) {
+      ++lspot;
+    }
+    if (r_p && rspot->max() == max) {
+      ++rspot;
+    }
+    if (max == detail::maximum<METRIC>()) {
+      break;
+    }
+    pos   = ++METRIC{max};
+    pos_p = true;
+  }
+  flush();
+}
+
+template <typename PAYLOAD>
+auto
+IPSpace<PAYLOAD>::apply(Diff const &diff) -> self_type & {
+  for (auto const &change : diff) {
+    if (change._after.has_value()) {
+      this->mark(change._range, *change._after);
+    } else {
+      this->erase(change._range);
+    }
+  }
+  return *this;
+}
+
 template <typename PAYLOAD>
 size_t
 IPSpace<PAYLOAD>::count(sa_family_t f) const {
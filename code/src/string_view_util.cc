@@ -6,6 +6,7 @@
 */
 
 #include "swoc/string_view_util.h"
+#include "swoc/TextView.h"
 
 int
 memcmp(std::string_view const &lhs, std::string_view const &rhs) {
@@ -31,7 +32,7 @@ strcasecmp(const std::string_view &lhs, const std::string_view &rhs) {
   int zret = 0;
   size_t n = rhs.size();
 
-  // Seems a bit ugly but size comparisons must be done anyway to get the @c strncasecmp args.
+  // Seems a bit ugly but size comparisons must be done anyway to get the compare args.
   if (lhs.size() < rhs.size()) {
     zret = 1;
     n    = lhs.size();
@@ -41,7 +42,12 @@ strcasecmp(const std::string_view &lhs, const std::string_view &rhs) {
     return 0;
   }
 
-  int r = ::strncasecmp(lhs.data(), rhs.data(), n);
+  int r = swoc::detail::casecmp(lhs.data(), rhs.data(), n);
 
   return r ? r : zret;
 }
+
+bool
+strcaseeq(const std::string_view &lhs, const std::string_view &rhs) {
+  return lhs.size() == rhs.size() && (lhs.data() == rhs.data() || 0 == swoc::detail::casecmp(lhs.data(), rhs.data(), lhs.size()));
+}
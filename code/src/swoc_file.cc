@@ -5,6 +5,8 @@
     Minimalist version of std::filesystem.
  */
 
+#include <cerrno>
+#include <cstring>
 #include <fcntl.h>
 #include <unistd.h>
 #include "swoc/swoc_file.h"
@@ -194,6 +196,90 @@ load(const path &p, std::error_code &ec) {
   return zret;
 }
 
+std::error_code
+line_reader::open(path const &p) {
+  this->close();
+  _fd = ::open(p.c_str(), O_RDONLY);
+  if (_fd < 0) {
+    return std::error_code(errno, std::system_category());
+  }
+#if defined(POSIX_FADV_SEQUENTIAL)
+  ::posix_fadvise(_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+  return {};
+}
+
+void
+line_reader::close() {
+  if (_fd >= 0) {
+    ::close(_fd);
+    _fd = -1;
+  }
+  _data.clear();
+  _scanned = 0;
+  _line_no = 0;
+  _eof_p   = false;
+  _ec.clear();
+}
+
+bool
+line_reader::fill() {
+  if (_fd < 0 || _eof_p) {
+    return false;
+  }
+  // Move the partial line to the start of the buffer, growing it if the line fills the buffer.
+  if (_data.size() >= _capacity) {
+    auto capacity = _capacity ? _capacity * 2 : DEFAULT_BLOCK_SIZE;
+    std::unique_ptr<char[]> buf{new char[capacity]};
+    memcpy(buf.get(), _data.data(), _data.size());
+    _buf      = std::move(buf);
+    _capacity = capacity;
+  } else if (_data.data() != _buf.get()) {
+    memmove(_buf.get(), _data.data(), _data.size());
+  }
+  _data.assign(_buf.get(), _data.size());
+
+  while (true) {
+    auto n = ::read(_fd, _buf.get() + _data.size(), _capacity - _data.size());
+    if (n > 0) {
+      _data.assign(_buf.get(), _data.size() + n);
+      return true;
+    } else if (n < 0 && errno == EINTR) {
+      continue;
+    } else if (n < 0) {
+      _ec = std::error_code(errno, std::system_category());
+    }
+    _eof_p = true;
+    return false;
+  }
+}
+
+bool
+line_reader::next(TextView &line) {
+  while (true) {
+    auto idx = TextView{_data.data() + _scanned, _data.size() - _scanned}.find('\n');
+    if (idx != TextView::npos) {
+      line     = _data.take_prefix(_scanned + idx);
+      _scanned = 0;
+      ++_line_no;
+      return true;
+    }
+    _scanned = _data.size();
+    if (!this->fill()) {
+      break;
+    }
+  }
+  // Trailing line without a terminator.
+  _scanned = 0;
+  if (_data.empty()) {
+    return false;
+  }
+  line = _data;
+  _data.clear();
+  ++_line_no;
+  return true;
+}
+
 } // namespace file
 
 BufferWriter &
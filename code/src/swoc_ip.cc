@@ -31,6 +31,98 @@ Set_Sockaddr_Len(T *addr) {
   Set_Sockaddr_Len_Case(addr, swoc::meta::CaseArg);
 }
 
+/* Network decomposition.
+ *
+ * The largest network starting at address @a lo is limited by the alignment of @a lo (the number
+ * of trailing zero bits) and by the number of addresses remaining in the range (the floor of the
+ * base 2 log of the span). These are the values returned by the @c ip*_net_bits functions - the
+ * CIDR value is the address width less the number of host bits.
+ */
+
+/// @return The number of host bits of the largest network at @a lo that ends at or before @a hi.
+unsigned
+ip4_net_bits(uint32_t lo, uint32_t hi) {
+  // The span can be 2^32 for the entire address space, which doesn't fit in 32 bits.
+  uint64_t span  = uint64_t{hi} - lo + 1;
+  unsigned align = lo ? __builtin_ctz(lo) : swoc::IP4Addr::WIDTH;
+  unsigned fit   = std::numeric_limits<uint64_t>::digits - 1 - __builtin_clzll(span);
+  return std::min(align, fit);
+}
+
+/** Compute the number of host bits for an IPv6 network.
+ *
+ * @param lo_msw Most significant word of the starting address.
+ * @param lo_lsw Least significant word of the starting address.
+ * @param hi_msw Most significant word of the ending address.
+ * @param hi_lsw Least significant word of the ending address.
+ * @return The number of host bits of the largest network at @a lo that ends at or before @a hi.
+ */
+unsigned
+ip6_net_bits(uint64_t lo_msw, uint64_t lo_lsw, uint64_t hi_msw, uint64_t hi_lsw) {
+  static constexpr unsigned W = std::numeric_limits<uint64_t>::digits;
+  // 128 bit span, which wraps to zero only for the entire address space.
+  uint64_t span_lsw = hi_lsw - lo_lsw + 1;
+  uint64_t span_msw = hi_msw - lo_msw - (hi_lsw < lo_lsw) + (span_lsw == 0);
+  unsigned fit      = span_msw ? 2 * W - 1 - __builtin_clzll(span_msw) : span_lsw ? W - 1 - __builtin_clzll(span_lsw) : 2 * W;
+  unsigned align    = lo_lsw ? __builtin_ctzll(lo_lsw) : lo_msw ? W + __builtin_ctzll(lo_msw) : 2 * W;
+  return std::min(align, fit);
+}
+
+/** Decompose an IPv4 range in to networks.
+ *
+ * @param lo Minimum address, host order.
+ * @param hi Maximum address, host order.
+ * @param f Functor invoked as @c f(addr, cidr) for each network, in order.
+ * @return The number of networks.
+ */
+template <typename F>
+size_t
+ip4_decompose(uint32_t lo, uint32_t hi, F &&f) {
+  size_t n = 0;
+  while (true) {
+    auto bits = ip4_net_bits(lo, hi);
+    f(lo, swoc::IP4Addr::WIDTH - bits);
+    ++n;
+    // Network end - @a lo is aligned so this can't carry, and the shift can't overflow 64 bits.
+    uint32_t end = lo | static_cast<uint32_t>((uint64_t{1} << bits) - 1);
+    if (end == hi) {
+      break;
+    }
+    lo = end + 1;
+  }
+  return n;
+}
+
+/** Decompose an IPv6 range in to networks.
+ *
+ * @param lo_msw Most significant word of the minimum address.
+ * @param lo_lsw Least significant word of the minimum address.
+ * @param hi_msw Most significant word of the maximum address.
+ * @param hi_lsw Least significant word of the maximum address.
+ * @param f Functor invoked as @c f(msw, lsw, cidr) for each network, in order.
+ * @return The number of networks.
+ */
+template <typename F>
+size_t
+ip6_decompose(uint64_t lo_msw, uint64_t lo_lsw, uint64_t hi_msw, uint64_t hi_lsw, F &&f) {
+  static constexpr unsigned W     = std::numeric_limits<uint64_t>::digits;
+  static constexpr uint64_t ONES = std::numeric_limits<uint64_t>::max();
+  size_t n                        = 0;
+  while (true) {
+    auto bits = ip6_net_bits(lo_msw, lo_lsw, hi_msw, hi_lsw);
+    f(lo_msw, lo_lsw, swoc::IP6Addr::WIDTH - bits);
+    ++n;
+    uint64_t end_lsw = lo_lsw | (bits >= W ? ONES : (uint64_t{1} << bits) - 1);
+    uint64_t end_msw = lo_msw | (bits <= W ? 0 : bits >= 2 * W ? ONES : (uint64_t{1} << (bits - W)) - 1);
+    if (end_msw == hi_msw && end_lsw == hi_lsw) {
+      break;
+    }
+    lo_lsw = end_lsw + 1;
+    lo_msw = end_msw + (lo_lsw == 0);
+  }
+  return n;
+}
+
 } // namespace
 
 namespace swoc { inline namespace SWOC_VERSION_NS {
@@ -757,9 +849,22 @@ IP4Range::network_mask() const {
   return {}; // default constructed (invalid) mask.
 }
 
+size_t
+IP4Range::networks(MemSpan<IP4Net> nets) const {
+  if (this->empty()) {
+    return 0;
+  }
+  size_t idx = 0;
+  return ip4_decompose(_min.host_order(), _max.host_order(), [&](uint32_t addr, unsigned cidr) {
+    if (idx < nets.count()) {
+      nets[idx++] = IP4Net{IP4Addr{addr}, IPMask(cidr)};
+    }
+  });
+}
+
 IP4Range::NetSource::NetSource(IP4Range::NetSource::range_type const &range) : _range(range) {
   if (!_range.empty()) {
-    this->search_wider();
+    this->set_mask();
   }
 }
 
@@ -771,11 +876,7 @@ IP4Range::NetSource::operator++() -> self_type & {
   } else {
     _range.assign_min(++upper);
     // @a _range is not empty, because there's at least one address still not covered.
-    if (this->is_valid(_mask)) {
-      this->search_wider();
-    } else {
-      this->search_narrower();
-    }
+    this->set_mask();
   }
   return *this;
 }
@@ -787,26 +888,11 @@ auto IP4Range::NetSource::operator++(int) -> self_type {
 }
 
 void
-IP4Range::NetSource::search_wider() {
-  while (_cidr > 0) {
-    auto m = _mask;
-    m <<= 1;
-    if (this->is_valid(m)) {
-      _mask = m;
-      --_cidr;
-    } else {
-      break;
-    }
-  }
-}
-
-void
-IP4Range::NetSource::search_narrower() {
-  while (!this->is_valid(_mask)) {
-    _mask._addr >>= 1;
-    _mask._addr |= 1U << (IP4Addr::WIDTH - 1); // put top bit back.
-    ++_cidr;
-  }
+IP4Range::NetSource::set_mask() {
+  auto bits = ip4_net_bits(_range.min().host_order(), _range.max().host_order());
+  _cidr     = IP4Addr::WIDTH - bits;
+  // 64 bit shift so that a width of 32 works.
+  _mask = IP4Addr{static_cast<in_addr_t>(~((uint64_t{1} << bits) - 1))};
 }
 
 // +++ IP6Range +++
@@ -948,6 +1034,35 @@ IPRange::network_mask() const {
   return {};
 }
 
+size_t
+IPRange::networks(MemSpan<IPNet> nets) const {
+  if (this->empty()) {
+    return 0;
+  }
+  size_t idx = 0;
+  switch (_family) {
+  case AF_INET:
+    return ip4_decompose(_range._ip4.min().host_order(), _range._ip4.max().host_order(), [&](uint32_t addr, unsigned cidr) {
+      if (idx < nets.count()) {
+        nets[idx++] = IPNet{IPAddr{IP4Addr{addr}}, IPMask(cidr)};
+      }
+    });
+  case AF_INET6: {
+    auto const &lo = _range._ip6.min()._addr._store;
+    auto const &hi = _range._ip6.max()._addr._store;
+    return ip6_decompose(lo[IP6Addr::MSW], lo[IP6Addr::LSW], hi[IP6Addr::MSW], hi[IP6Addr::LSW],
+                         [&](uint64_t msw, uint64_t lsw, unsigned cidr) {
+                           if (idx < nets.count()) {
+                             nets[idx++] = IPNet{IPAddr{IP6Addr{msw, lsw}}, IPMask(cidr)};
+                           }
+                         });
+  }
+  default:
+    break;
+  }
+  return 0;
+}
+
 bool
 IPRange::operator==(self_type const &that) const {
   if (_family != that._family) {
@@ -971,9 +1086,23 @@ IP6Range::network_mask() const {
   return {}; // default constructed (invalid) mask.
 }
 
+size_t
+IP6Range::networks(MemSpan<IP6Net> nets) const {
+  if (this->empty()) {
+    return 0;
+  }
+  size_t idx = 0;
+  return ip6_decompose(_min._addr._store[IP6Addr::MSW], _min._addr._store[IP6Addr::LSW], _max._addr._store[IP6Addr::MSW],
+                       _max._addr._store[IP6Addr::LSW], [&](uint64_t msw, uint64_t lsw, unsigned cidr) {
+                         if (idx < nets.count()) {
+                           nets[idx++] = IP6Net{IP6Addr{msw, lsw}, IPMask(cidr)};
+                         }
+                       });
+}
+
 IP6Range::NetSource::NetSource(IP6Range::NetSource::range_type const &range) : _range(range) {
   if (!_range.empty()) {
-    this->search_wider();
+    this->set_mask();
   }
 }
 
@@ -985,33 +1114,16 @@ IP6Range::NetSource::operator++() -> self_type & {
   } else {
     _range.assign_min(++upper);
     // @a _range is not empty, because there's at least one address still not covered.
-    if (this->is_valid(_mask)) {
-      this->search_wider();
-    } else {
-      this->search_narrower();
-    }
+    this->set_mask();
   }
   return *this;
 }
 
 void
-IP6Range::NetSource::search_wider() {
-  while (_mask.width() > 0) {
-    auto m = _mask;
-    m <<= 1;
-    if (this->is_valid(m)) {
-      _mask = m;
-    } else {
-      break;
-    }
-  }
-}
-
-void
-IP6Range::NetSource::search_narrower() {
-  while (!this->is_valid(_mask)) {
-    _mask >>= 1;
-  }
+IP6Range::NetSource::set_mask() {
+  auto const &lo = _range.min()._addr._store;
+  auto const &hi = _range.max()._addr._store;
+  _mask = IPMask(IP6Addr::WIDTH - ip6_net_bits(lo[IP6Addr::MSW], lo[IP6Addr::LSW], hi[IP6Addr::MSW], hi[IP6Addr::LSW]));
 }
 
 }} // namespace swoc::SWOC_VERSION_NS
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <fstream>
 #include "swoc/TextView.h"
+#include "swoc/TextTokenizer.h"
 #include "swoc/swoc_file.h"
 #include "swoc/bwf_std.h"
 
@@ -20,6 +21,7 @@ using namespace std::literals;
 using namespace swoc::literals;
 
 using swoc::TextView;
+using swoc::TextTokenizer;
 using swoc::svtou;
 swoc::LocalBufferWriter<1024> W;
 
@@ -39,13 +41,14 @@ int main(int, char *[]) {
   FILE * f = fopen("/proc/diskstats", "r");
 
   while (fgets(buffer, sizeof(buffer), f)) {
+    static constexpr swoc::CharSet SEPARATORS{" \n"};
     DiskInfo item;
-    TextView txt{buffer, strlen(buffer)};
-    item.id = svtou(txt.ltrim(' ').take_prefix_at(' '));
-    item.idx = svtou(txt.ltrim(' ').take_prefix_at(' '));
-    item.name = txt.ltrim(' ').take_prefix_at(' ');
-    while (txt.ltrim(' ')) {
-      item.data.push_back(svtou(txt.take_prefix_at(' ')));
+    auto fields = TextTokenizer::fields(TextView{buffer, strlen(buffer)}, SEPARATORS, true);
+    item.id = svtou(fields.next());
+    item.idx = svtou(fields.next());
+    item.name = fields.next();
+    for (auto token : fields) {
+      item.data.push_back(svtou(token));
     }
     info.emplace_back(item);
   }
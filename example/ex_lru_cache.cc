@@ -10,6 +10,7 @@
 #include <chrono>
 #include <utility>
 #include <thread>
+#include <condition_variable>
 
 #include "swoc/TextView.h"
 #include "swoc/swoc_ip.h"
@@ -22,8 +22,8 @@
 #include "swoc/swoc_ip.h"
 #include "swoc/bwf_ip.h"
 #include "swoc/bwf_std.h"
-#include "swoc/bwf_std.h"
 #include "swoc/swoc_file.h"
+#include "swoc/IPSpaceLoader.h"
 
 using namespace std::literals;
 using namespace swoc::literals;
@@ -40,32 +40,6 @@ using Space = swoc::IPSpace<std::monostate>;
 
 void post_processing_performance_test(Space & space);
 
-/// Process the @a content of a file in to @a space.
-unsigned process(Space& space, TextView content) {
-  int line_no = 0; /// Track for error reporting.
-  unsigned n_ranges = 0;
-
-  // For each line in @a content
-  while (content) {
-    TextView line = content.take_prefix_at('\n').trim_if(&isspace);
-    ++line_no;
-    // Allow empty lines and '#' comments without error.
-    if (line.empty() || '#' == *line) {
-      continue;
-    }
-
-    // Get the range, make sure it's a valid range.
-    IPRange range{line};
-    if (range.empty()) {
-      std::cerr << W().print("Invalid range '{}' on line {}\n", line, line_no);
-      continue;
-    }
-    ++n_ranges;
-    space.mark(range, std::monostate{});
-  }
-  return n_ranges;
-}
-
 int main(int argc, char *argv[]) {
   Space space;
 
@@ -75,24 +49,26 @@ int main(int argc, char *argv[]) {
   }
 
   auto t0 = std::chrono::system_clock::now(); // timing
-  // Load the file.
-  swoc::file::path path{argv[1]};
-  std::error_code ec;
-  std::string content = swoc::file::load(path, ec);
-  if (ec) {
-    std::cerr << W().print(R"(Failed to open file "{}" - {}\n)", path, ec);
-    exit(1);
+  // Paint the IPSpace directly from the file. There is no payload, so every range is valid.
+  swoc::IPSpaceLoader<std::monostate> loader{space, [](TextView) -> swoc::Rv<std::monostate> { return std::monostate{}; }};
+  auto errata = loader.error_limit(0).load(swoc::file::path{argv[1]});
+  if (!errata.is_ok()) {
+    std::cerr << errata;
+    if (loader.line_count() == 0) {
+      exit(1);
+    }
   }
-  // Paint the IPSpace.
-  auto n_ranges = process(space, content);
+  auto n_ranges = loader.range_count();
 
   // Dump the results.
   unsigned n_nets = 0;
+  std::array<swoc::IPNet, IPRange::MAX_NETWORKS> nets;
   for ( auto && [range, payload] : space ) {
-    for ( auto && net : range.networks() ) {
-      ++n_nets;
+    auto n = range.networks(nets);
+    for ( auto && net : swoc::MemSpan<swoc::IPNet>{nets.data(), n} ) {
       std::cout << W().print("{}\n", net);
     }
+    n_nets += n;
   }
 
   auto delta = std::chrono::system_clock::now() - t0;
@@ -173,7 +173,7 @@ TEST_CASE("MemArena example", "[libswoc][MemArena][example]")
       static uint32_t
       hash_of(std::string_view const &s)
       {
-        return swoc::Hash32FNV1a().hash_immediate(swoc::transform_view_of(&toupper, s));
+        return swoc::Hash32FNV1a().hash_immediate_nocase(s);
       }
 
       static bool
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Apache Software Foundation 2019
+/** @file
+
+    ClockCache unit tests.
+*/
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#include "swoc/ClockCache.h"
+#include "catch.hpp"
+
+using swoc::ClockCache;
+
+TEST_CASE("ClockCache", "[libswoc][ClockCache]")
+{
+  // Single shard so the eviction order is predictable.
+  ClockCache<int, std::string, 1> cache(4);
+  REQUIRE(cache.capacity() == 4);
+  REQUIRE(cache.count() == 0);
+  REQUIRE_FALSE(cache.retrieve(1).has_value());
+
+  cache.insert(1, "one").insert(2, "two").insert(3, "three").insert(4, "four");
+  REQUIRE(cache.count() == 4);
+  REQUIRE(cache.retrieve(1).value() == "one");
+  REQUIRE(cache.retrieve(3).value() == "three");
+
+  // 2 is the oldest unreferenced item.
+  cache.insert(5, "five");
+  REQUIRE(cache.count() == 4);
+  REQUIRE_FALSE(cache.retrieve(2).has_value());
+  REQUIRE(cache.retrieve(1).has_value());
+  REQUIRE(cache.retrieve(3).has_value());
+  REQUIRE(cache.retrieve(4).has_value());
+  REQUIRE(cache.retrieve(5).has_value());
+
+  // Update in place.
+  cache.insert(4, "FOUR");
+  REQUIRE(cache.count() == 4);
+  REQUIRE(cache.retrieve(4).value() == "FOUR");
+
+  REQUIRE(cache.erase(3));
+  REQUIRE_FALSE(cache.erase(3));
+  REQUIRE(cache.count() == 3);
+  cache.insert(6, "six");
+  REQUIRE(cache.count() == 4);
+  REQUIRE(cache.retrieve(6).value() == "six");
+}
+
+TEST_CASE("ClockCache Scan", "[libswoc][ClockCache]")
+{
+  ClockCache<int, int, 4> cache(400);
+  // A working set that is used repeatedly.
+  for (int i = 0; i < 100; ++i) {
+    cache.insert(i, i);
+  }
+  // Interleave use of the working set with a scan of keys used once.
+  bool miss_p = false;
+  for (int i = 1000; i < 10000; ++i) {
+    cache.insert(i, i);
+    if (auto v = cache.retrieve(i % 100); !v || *v != i % 100) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+  REQUIRE(cache.count() <= cache.capacity());
+}
+
+TEST_CASE("ClockCache Threads", "[libswoc][ClockCache]")
+{
+  static constexpr int N_THREAD = 8;
+  static constexpr int N_ITER   = 20000;
+
+  ClockCache<int, std::string> cache(1000);
+  std::vector<std::thread> threads;
+  std::atomic<int> errors{0};
+  for (int t = 0; t < N_THREAD; ++t) {
+    threads.emplace_back([&, t]() -> void {
+      for (int i = 0; i < N_ITER; ++i) {
+        int key = (i * 7 + t * 131) % 3000;
+        if (auto v = cache.retrieve(key); v) {
+          if (*v != std::to_string(key)) {
+            ++errors;
+          }
+        } else {
+          cache.insert(key, std::to_string(key));
+        }
+        if (i % 97 == 0) {
+          cache.erase(key);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  REQUIRE(errors == 0);
+  REQUIRE(cache.count() <= cache.capacity());
+  REQUIRE(cache.count() > 0);
+}
@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Verizon Media 2020
+/** @file
+
+    B+ tree DiscreteSpace testing.
+*/
+
+#include "catch.hpp"
+
+#include <random>
+#include <vector>
+
+#include "swoc/DiscreteBTree.h"
+#include "swoc/swoc_ip.h"
+
+using swoc::DiscreteSpace;
+using swoc::DiscreteSpaceBTree;
+using swoc::IP4Addr;
+using swoc::IP4Range;
+
+namespace {
+// The metric must be a class type, use IPv4 addresses as a convenient integral metric.
+using BSpace  = DiscreteSpace<IP4Addr, unsigned, DiscreteSpaceBTree>;
+
+IP4Addr
+A(unsigned n) {
+  return IP4Addr{n};
+}
+
+IP4Range
+R(unsigned min, unsigned max) {
+  return {A(min), A(max)};
+}
+
+// Check that the space agrees with a value per metric @a model.
+bool
+same_values(BSpace const &bs, std::vector<unsigned> const &model) {
+  for (unsigned v = 0; v < model.size(); ++v) {
+    auto spot = bs.find(A(v));
+    if ((spot == bs.end() ? 0 : spot->payload()) != model[v]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Check ranges are ordered, disjoint, and coalesced.
+bool
+is_canonical(BSpace const &bs) {
+  size_t n = 0;
+  auto prev = bs.end();
+  for (auto spot = bs.begin(); spot != bs.end(); ++spot, ++n) {
+    if (spot->max() < spot->min()) {
+      return false;
+    }
+    if (prev != bs.end()) {
+      if (!(prev->max() < spot->min())) {
+        return false;
+      }
+      if (++IP4Addr{prev->max()} == spot->min() && prev->payload() == spot->payload()) {
+        return false;
+      }
+    }
+    prev = spot;
+  }
+  return n == bs.count();
+}
+} // namespace
+
+TEST_CASE("DiscreteSpace BTree basic", "[libswoc][DiscreteSpace][btree]") {
+  BSpace space;
+
+  REQUIRE(space.count() == 0);
+  REQUIRE(space.begin() == space.end());
+  REQUIRE(space.find(A(10)) == space.end());
+
+  space.mark(R(100, 199), 1);
+  REQUIRE(space.count() == 1);
+  REQUIRE(space.find(A(99)) == space.end());
+  REQUIRE(space.find(A(100))->payload() == 1);
+  REQUIRE(space.find(A(199))->payload() == 1);
+  REQUIRE(space.find(A(200)) == space.end());
+
+  space.mark(R(120, 129), 2);
+  REQUIRE(space.count() == 3);
+  REQUIRE(space.find(A(125))->payload() == 2);
+  REQUIRE(space.find(A(130))->payload() == 1);
+
+  space.mark(R(120, 129), 1); // should coalesce back to a single range.
+  REQUIRE(space.count() == 1);
+  REQUIRE(space.find(A(125))->range() == R(100, 199));
+
+  space.fill(R(50, 250), 3);
+  REQUIRE(space.count() == 3);
+  REQUIRE(space.find(A(50))->payload() == 3);
+  REQUIRE(space.find(A(150))->payload() == 1);
+  REQUIRE(space.find(A(250))->payload() == 3);
+
+  space.erase(R(140, 160));
+  REQUIRE(space.count() == 4);
+  REQUIRE(space.find(A(150)) == space.end());
+
+  auto BF = [](unsigned &lhs, unsigned rhs) -> bool {
+    lhs |= rhs;
+    return true;
+  };
+  space.blend(R(0, 300), 4, BF);
+  REQUIRE(space.count() == 7);
+  REQUIRE(space.find(A(0))->payload() == 4);
+  REQUIRE(space.find(A(60))->payload() == 7);
+  REQUIRE(space.find(A(110))->payload() == 5);
+  REQUIRE(space.find(A(150))->payload() == 4);
+  REQUIRE(space.find(A(300))->payload() == 4);
+
+  // Reverse iteration.
+  auto spot = space.end();
+  --spot;
+  REQUIRE(spot->max() == A(300));
+
+  // Full range of the metric.
+  space.mark(R(0, std::numeric_limits<unsigned>::max()), 9);
+  REQUIRE(space.count() == 1);
+  space.erase(R(0, std::numeric_limits<unsigned>::max()));
+  REQUIRE(space.count() == 0);
+
+  space.mark(R(10, 20), 1);
+  space.clear();
+  REQUIRE(space.count() == 0);
+  REQUIRE(space.begin() == space.end());
+}
+
+TEST_CASE("DiscreteSpace BTree sequential", "[libswoc][DiscreteSpace][btree]") {
+  BSpace space;
+  static constexpr unsigned N = 20000;
+
+  // Enough ranges to build several tree levels.
+  for (unsigned i = 0; i < N; ++i) {
+    space.mark(R(i * 4, i * 4 + 2), i);
+  }
+  REQUIRE(space.count() == N);
+  REQUIRE(is_canonical(space));
+  for (unsigned i = 0; i < N; ++i) {
+    auto spot = space.find(A(i * 4 + 1));
+    REQUIRE(spot != space.end());
+    REQUIRE(spot->payload() == i);
+    REQUIRE(space.find(A(i * 4 + 3)) == space.end());
+  }
+
+  // Remove every other range to force merges all through the tree.
+  for (unsigned i = 0; i < N; i += 2) {
+    space.erase(R(i * 4, i * 4 + 2));
+  }
+  REQUIRE(space.count() == N / 2);
+  REQUIRE(is_canonical(space));
+  for (unsigned i = 1; i < N; i += 2) {
+    REQUIRE(space.find(A(i * 4))->payload() == i);
+  }
+
+  // Insert in reverse order.
+  space.clear();
+  for (unsigned i = N; i > 0; --i) {
+    space.mark(R(i * 4, i * 4 + 2), i);
+  }
+  REQUIRE(space.count() == N);
+  REQUIRE(is_canonical(space));
+  unsigned n = 0;
+  for (auto spot = space.end(); spot != space.begin();) {
+    --spot;
+    ++n;
+  }
+  REQUIRE(n == N);
+
+  space.erase(R(0, N * 4 + 10));
+  REQUIRE(space.count() == 0);
+}
+
+TEST_CASE("DiscreteSpace BTree random", "[libswoc][DiscreteSpace][btree]") {
+  static constexpr unsigned LIMIT = 20000;
+  std::minstd_rand rng(1337);
+  std::uniform_int_distribution<unsigned> value(0, LIMIT);
+  std::uniform_int_distribution<unsigned> width(0, 30);
+  std::uniform_int_distribution<unsigned> color(1, 4);
+  std::uniform_int_distribution<unsigned> op(0, 3);
+
+  auto BF = [](unsigned &lhs, unsigned rhs) -> bool {
+    lhs ^= rhs;
+    return lhs != 0;
+  };
+
+  // Zero is used in the model for "no payload".
+  BSpace bs;
+  std::vector<unsigned> model(LIMIT + 1, 0);
+  for (unsigned i = 0; i < 20000; ++i) {
+    auto min = value(rng);
+    auto max = std::min(LIMIT, min + width(rng));
+    auto r   = R(min, max);
+    auto c   = color(rng);
+    switch (op(rng)) {
+    case 0:
+      bs.mark(r, c);
+      std::fill(model.begin() + min, model.begin() + max + 1, c);
+      break;
+    case 1:
+      bs.fill(r, c);
+      std::replace(model.begin() + min, model.begin() + max + 1, 0U, c);
+      break;
+    case 2:
+      bs.blend(r, c, BF);
+      std::for_each(model.begin() + min, model.begin() + max + 1, [=](unsigned &v) { v ^= c; });
+      break;
+    case 3:
+      bs.erase(r);
+      std::fill(model.begin() + min, model.begin() + max + 1, 0U);
+      break;
+    }
+    if (i % 2000 == 0) {
+      REQUIRE(is_canonical(bs));
+      REQUIRE(same_values(bs, model));
+    }
+  }
+  REQUIRE(is_canonical(bs));
+  REQUIRE(same_values(bs, model));
+}
+
+TEST_CASE("DiscreteSpace BTree IP", "[libswoc][DiscreteSpace][btree][ip]") {
+  using swoc::IP6Addr;
+  using swoc::IP6Range;
+
+  BSpace space4;
+  space4.mark(IP4Range{"10.0.0.0/8"}, 1);
+  space4.mark(IP4Range{"10.1.0.0/16"}, 2);
+  REQUIRE(space4.count() == 3);
+  REQUIRE(space4.find(IP4Addr{"10.1.2.3"})->payload() == 2);
+  REQUIRE(space4.find(IP4Addr{"10.2.2.3"})->payload() == 1);
+  REQUIRE(space4.find(IP4Addr{"11.0.0.0"}) == space4.end());
+
+  DiscreteSpace<IP6Addr, unsigned, DiscreteSpaceBTree> space6;
+  space6.mark(IP6Range{"2001:db8::/32"}, 1);
+  space6.erase(IP6Range{"2001:db8:1::/48"});
+  REQUIRE(space6.count() == 2);
+  REQUIRE(space6.find(IP6Addr{"2001:db8:1::1"}) == space6.end());
+  REQUIRE(space6.find(IP6Addr{"2001:db8:2::1"})->payload() == 1);
+}
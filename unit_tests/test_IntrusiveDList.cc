@@ -22,6 +22,8 @@
 #include <string_view>
 #include <string>
 #include <algorithm>
+#include <random>
+#include <vector>
 
 #include "swoc/IntrusiveDList.h"
 #include "swoc/bwf_base.h"
@@ -56,6 +58,40 @@ struct Thing {
 
 using ThingList = IntrusiveDList<Thing::Linkage>;
 
+// Sortable element, @a _seq is used to check stability.
+struct Ranked {
+  int _rank;
+  int _seq;
+  Ranked *_next{nullptr};
+  Ranked *_prev{nullptr};
+
+  Ranked(int rank, int seq) : _rank(rank), _seq(seq) {}
+
+  bool
+  operator<(Ranked const &that) const
+  {
+    return _rank < that._rank;
+  }
+};
+
+using RankedList = IntrusiveDList<swoc::IntrusiveLinkage<Ranked>>;
+
+// Check the links and count are consistent, and the elements are in non-decreasing order.
+bool
+is_sorted_list(RankedList const &list)
+{
+  size_t n            = 0;
+  Ranked const *prior = nullptr;
+  for (auto const &r : list) {
+    if (r._prev != prior || (prior && (r < *prior || (prior->_rank == r._rank && prior->_seq > r._seq)))) {
+      return false;
+    }
+    prior = &r;
+    ++n;
+  }
+  return n == list.count() && prior == list.tail();
+}
+
 } // namespace
 
 TEST_CASE("IntrusiveDList", "[libswoc][IntrusiveDList]")
@@ -130,3 +166,105 @@ TEST_CASE("IntrusiveDList", "[libswoc][IntrusiveDList]")
   REQUIRE(list.count() == 4);
   REQUIRE(list.tail()->_payload == "trailer");
 }
+
+TEST_CASE("IntrusiveDList Rearrange", "[libswoc][IntrusiveDList]")
+{
+  std::vector<Ranked> items;
+  auto ranks = [](RankedList const &list) {
+    std::vector<int> zret;
+    for (auto const &r : list) {
+      zret.push_back(r._rank);
+    }
+    return zret;
+  };
+  for (int i = 0; i < 10; ++i) {
+    items.emplace_back(i, i);
+  }
+
+  RankedList l1, l2;
+  for (int i = 0; i < 5; ++i) {
+    l1.append(&items[i]);
+    l2.append(&items[i + 5]);
+  }
+
+  // Whole list, in the middle.
+  l1.splice(l1.iterator_for(&items[2]), l2);
+  REQUIRE(l2.empty());
+  REQUIRE(l2.count() == 0);
+  REQUIRE(l1.count() == 10);
+  REQUIRE(ranks(l1) == std::vector<int>{0, 1, 5, 6, 7, 8, 9, 2, 3, 4});
+
+  // Range from the same list, to the front.
+  l1.splice(l1.begin(), l1, l1.iterator_for(&items[5]), l1.iterator_for(&items[2]));
+  REQUIRE(l1.count() == 10);
+  REQUIRE(ranks(l1) == std::vector<int>{5, 6, 7, 8, 9, 0, 1, 2, 3, 4});
+  REQUIRE(l1.head()->_prev == nullptr);
+
+  // Range to another list, including the tail.
+  l2.splice(l2.end(), l1, l1.iterator_for(&items[2]), l1.end());
+  REQUIRE(l1.count() == 7);
+  REQUIRE(l2.count() == 3);
+  REQUIRE(ranks(l2) == std::vector<int>{2, 3, 4});
+  REQUIRE(l1.tail() == &items[1]);
+  REQUIRE(l1.tail()->_next == nullptr);
+
+  // Empty range.
+  l2.splice(l2.begin(), l1, l1.begin(), l1.begin());
+  REQUIRE(l1.count() == 7);
+  REQUIRE(l2.count() == 3);
+
+  l1.sort();
+  REQUIRE(is_sorted_list(l1));
+  REQUIRE(ranks(l1) == std::vector<int>{0, 1, 5, 6, 7, 8, 9});
+
+  l1.merge(l2);
+  REQUIRE(l2.empty());
+  REQUIRE(is_sorted_list(l1));
+  REQUIRE(ranks(l1) == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+
+  auto spot = l1.partition([](Ranked const &r) { return r._rank % 2 == 1; });
+  REQUIRE(spot == l1.iterator_for(&items[0]));
+  REQUIRE(ranks(l1) == std::vector<int>{1, 3, 5, 7, 9, 0, 2, 4, 6, 8});
+  REQUIRE(l1.count() == 10);
+  REQUIRE(l1.tail() == &items[8]);
+  REQUIRE(l1.partition([](Ranked const &) { return true; }) == l1.end());
+  REQUIRE(l1.partition([](Ranked const &) { return false; }) == l1.begin());
+  REQUIRE(ranks(l1) == std::vector<int>{1, 3, 5, 7, 9, 0, 2, 4, 6, 8});
+
+  // Descending, with a comparison functor.
+  l1.sort([](Ranked const &lhs, Ranked const &rhs) { return lhs._rank > rhs._rank; });
+  REQUIRE(ranks(l1) == std::vector<int>{9, 8, 7, 6, 5, 4, 3, 2, 1, 0});
+
+  RankedList empty;
+  empty.sort();
+  REQUIRE(empty.empty());
+  l1.merge(empty);
+  REQUIRE(l1.count() == 10);
+}
+
+TEST_CASE("IntrusiveDList Sort", "[libswoc][IntrusiveDList]")
+{
+  static constexpr int N = 10000;
+  std::minstd_rand rng(7);
+  std::vector<Ranked> items;
+  items.reserve(N);
+  RankedList list;
+  for (int i = 0; i < N; ++i) {
+    list.append(&items.emplace_back(int(rng() % 100), i)); // lots of duplicates.
+  }
+  list.sort();
+  REQUIRE(list.count() == N);
+  REQUIRE(is_sorted_list(list));
+
+  // Merge two sorted lists with equal elements, those from the target list must come first.
+  RankedList other;
+  std::vector<Ranked> more;
+  more.reserve(N);
+  for (int i = 0; i < N; ++i) {
+    other.append(&more.emplace_back(i / 100, N + i));
+  }
+  list.merge(other);
+  REQUIRE(other.empty());
+  REQUIRE(list.count() == 2 * N);
+  REQUIRE(is_sorted_list(list));
+}
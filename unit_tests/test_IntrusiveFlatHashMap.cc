@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Apache Software Foundation 2019
+/** @file
+
+    IntrusiveFlatHashMap unit tests.
+*/
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <random>
+
+#include "swoc/IntrusiveFlatHashMap.h"
+#include "swoc/bwf_base.h"
+#include "catch.hpp"
+
+using swoc::IntrusiveFlatHashMap;
+
+using namespace std::literals;
+
+namespace
+{
+struct Thing {
+  std::string _payload;
+  int _n{0};
+
+  Thing(std::string_view text, int x) : _payload(text), _n(x) {}
+
+  Thing *_next{nullptr};
+  Thing *_prev{nullptr};
+};
+
+struct ThingMapDescriptor {
+  static Thing *&
+  next_ptr(Thing *thing)
+  {
+    return thing->_next;
+  }
+  static Thing *&
+  prev_ptr(Thing *thing)
+  {
+    return thing->_prev;
+  }
+  static std::string_view
+  key_of(Thing *thing)
+  {
+    return thing->_payload;
+  }
+  static size_t
+  hash_of(std::string_view s)
+  {
+    return std::hash<std::string_view>{}(s);
+  }
+  static bool
+  equal(std::string_view const &lhs, std::string_view const &rhs)
+  {
+    return lhs == rhs;
+  }
+};
+
+using Map = IntrusiveFlatHashMap<ThingMapDescriptor>;
+
+// Integer keys with an identity hash, to check the hash is mixed.
+struct Number {
+  unsigned _n;
+  Number *_next{nullptr};
+  Number *_prev{nullptr};
+
+  explicit Number(unsigned n) : _n(n) {}
+};
+
+struct NumberMapDescriptor {
+  static Number *&
+  next_ptr(Number *n)
+  {
+    return n->_next;
+  }
+  static Number *&
+  prev_ptr(Number *n)
+  {
+    return n->_prev;
+  }
+  static unsigned
+  key_of(Number *n)
+  {
+    return n->_n;
+  }
+  static unsigned
+  hash_of(unsigned n)
+  {
+    return n;
+  }
+  static bool
+  equal(unsigned lhs, unsigned rhs)
+  {
+    return lhs == rhs;
+  }
+};
+
+} // namespace
+
+TEST_CASE("IntrusiveFlatHashMap", "[libswoc][IntrusiveFlatHashMap]")
+{
+  Map map;
+  REQUIRE(map.capacity() == 0);
+  REQUIRE(map.find("bob"sv) == map.end());
+  map.insert(new Thing("bob", 1));
+  map.insert(new Thing("dave", 2));
+  map.insert(new Thing("persia", 3));
+  REQUIRE(map.count() == 3);
+  REQUIRE(map.capacity() >= Map::GROUP_WIDTH);
+  REQUIRE(map.find("dave"sv) != map.end());
+  REQUIRE(map.find("dave"sv)->_n == 2);
+  REQUIRE(map.find("sam"sv) == map.end());
+
+  // Duplicates are adjacent and in insertion order.
+  map.insert(new Thing("dave", 4));
+  map.insert(new Thing("bob", 5));
+  map.insert(new Thing("dave", 6));
+  auto r = map.equal_range("dave"sv);
+  std::vector<int> found;
+  for (auto &thing : r) {
+    found.push_back(thing._n);
+  }
+  REQUIRE(found == std::vector<int>{2, 4, 6});
+  REQUIRE(map.find("bob"sv)->_n == 1);
+
+  // Erase the first duplicate, the next becomes the first.
+  Thing *thing = map.find("dave"sv);
+  REQUIRE(map.erase(thing));
+  REQUIRE_FALSE(map.erase(thing));
+  delete thing;
+  REQUIRE(map.find("dave"sv)->_n == 4);
+  REQUIRE(map.count() == 5);
+
+  thing     = map.find("persia"sv);
+  auto spot = map.erase(map.find("persia"sv));
+  delete thing;
+  REQUIRE(map.find("persia"sv) == map.end());
+  REQUIRE(spot != map.begin());
+
+  map.apply([](Thing *thing) { delete thing; });
+  map.clear();
+  REQUIRE(map.count() == 0);
+  REQUIRE(map.begin() == map.end());
+  REQUIRE(map.find("bob"sv) == map.end());
+}
+
+TEST_CASE("IntrusiveFlatHashMap Many", "[libswoc][IntrusiveFlatHashMap]")
+{
+  constexpr int N = 5000;
+  Map map;
+  std::vector<std::string> names;
+  names.reserve(N);
+  for (int i = 0; i < N; ++i) {
+    swoc::bwprint(names.emplace_back(), "name {}", i);
+    map.insert(new Thing(names.back(), i));
+  }
+  REQUIRE(map.count() == N);
+  REQUIRE(map.capacity() * 7 / 8 >= N);
+
+  bool miss_p = false;
+  for (int i = 0; i < N; ++i) {
+    if (auto spot = map.find(names[i]); spot == map.end() || spot->_n != i) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+
+  // Insertion order is preserved.
+  int n = 0;
+  for (auto &thing : map) {
+    miss_p = miss_p || thing._n != n++;
+  }
+  REQUIRE(miss_p == false);
+
+  // Churn - erase and insert many times, to accumulate deleted slots.
+  std::minstd_rand randu;
+  std::uniform_int_distribution<int> pick{0, N - 1};
+  auto capacity = map.capacity();
+  for (int k = 0; k < 20 * N; ++k) {
+    int i        = pick(randu);
+    Thing *thing = map.find(names[i]);
+    miss_p       = miss_p || !map.erase(thing);
+    map.insert(thing);
+  }
+  REQUIRE(miss_p == false);
+  REQUIRE(map.count() == N);
+  REQUIRE(map.capacity() == capacity); // Deleted slots were reclaimed without growing.
+  for (int i = 0; i < N; ++i) {
+    if (auto spot = map.find(names[i]); spot == map.end() || spot->_n != i) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+  map.apply([](Thing *thing) { delete thing; });
+
+  // Weak hash.
+  IntrusiveFlatHashMap<NumberMapDescriptor> numbers(N);
+  auto cap = numbers.capacity();
+  std::vector<Number> data;
+  data.reserve(N);
+  for (unsigned i = 0; i < N; ++i) {
+    numbers.insert(&data.emplace_back(i << 12));
+  }
+  REQUIRE(numbers.capacity() == cap);
+  for (unsigned i = 0; i < N; ++i) {
+    if (auto spot = numbers.find(i << 12); spot == numbers.end() || spot->_n != i << 12) {
+      miss_p = true;
+    }
+    if (numbers.find((i << 12) + 1) != numbers.end()) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+}
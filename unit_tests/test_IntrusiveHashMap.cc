@@ -80,6 +80,57 @@ struct ThingMapDescriptor {
 
 using Map = IntrusiveHashMap<ThingMapDescriptor>;
 
+// Cache the hash value in the element and use multiply shift bucket indexing.
+struct CachedThing {
+  std::string _payload;
+  int _n{0};
+  size_t _hash{0};
+
+  CachedThing(std::string_view text, int x) : _payload(text), _n(x) {}
+
+  CachedThing *_next{nullptr};
+  CachedThing *_prev{nullptr};
+};
+
+struct CachedThingMapDescriptor {
+  static inline unsigned _equal_count = 0; ///< Number of calls to @c equal.
+
+  static CachedThing *&
+  next_ptr(CachedThing *thing)
+  {
+    return thing->_next;
+  }
+  static CachedThing *&
+  prev_ptr(CachedThing *thing)
+  {
+    return thing->_prev;
+  }
+  static std::string_view
+  key_of(CachedThing *thing)
+  {
+    return thing->_payload;
+  }
+  static size_t
+  hash_of(std::string_view s)
+  {
+    return std::hash<std::string_view>{}(s);
+  }
+  static size_t &
+  hash_cache(CachedThing *thing)
+  {
+    return thing->_hash;
+  }
+  static constexpr bool MULTIPLY_SHIFT = true;
+  static bool
+  equal(std::string_view const &lhs, std::string_view const &rhs)
+  {
+    ++_equal_count;
+    return lhs == rhs;
+  }
+};
+
+using CachedMap = IntrusiveHashMap<CachedThingMapDescriptor>;
+
 } // namespace
 
 TEST_CASE("IntrusiveHashMap", "[libts][IntrusiveHashMap]")
@@ -235,5 +286,295 @@ TEST_CASE("IntrusiveHashMapManyStrings", "[IntrusiveHashMap]")
   REQUIRE(miss_p == false);
 };
 
+TEST_CASE("IntrusiveHashMap Incremental", "[IntrusiveHashMap]")
+{
+  Map map;
+  map.set_incremental_expansion(true);
+  REQUIRE(map.get_incremental_expansion() == true);
+
+  constexpr int N = 2000;
+  std::vector<std::string> names;
+  names.reserve(N);
+  size_t nb    = map.bucket_count();
+  bool miss_p  = false;
+  bool order_p = true; // Elements with equal keys stay adjacent and in insertion order.
+  for (int i = 0; i < N; ++i) {
+    swoc::bwprint(names.emplace_back(), "name {}", i / 2); // Every name is used twice.
+    map.insert(new Thing(names.back(), i));
+    // Check the elements inserted most recently, which may be in either bucket array.
+    for (int k = std::max(0, i - 40); k <= i; ++k) {
+      if (auto spot = map.find(names[k]); spot == map.end() || spot->_n != (k & ~1)) {
+        miss_p = true;
+      } else if (k & 1) {
+        ++spot;
+        order_p = order_p && spot != map.end() && spot->_n == k;
+      }
+    }
+  }
+  REQUIRE(miss_p == false);
+  REQUIRE(order_p == true);
+  REQUIRE(map.count() == N);
+  REQUIRE(map.bucket_count() > nb);
+
+  // Every element is found, no matter how far along the migration is.
+  for (int i = 0; i < N; ++i) {
+    if (auto spot = map.find(names[i]); spot == map.end() || spot->_payload != names[i]) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+  size_t n = 0;
+  for ([[maybe_unused]] auto &thing : map) {
+    ++n;
+  }
+  REQUIRE(n == N);
+
+  // Erase half, then check the rest are still there.
+  for (int i = 0; i < N; i += 2) {
+    auto spot = map.find(names[i]);
+    REQUIRE(spot != map.end());
+    Thing *thing = spot;
+    map.erase(spot);
+    delete thing;
+  }
+  REQUIRE(map.count() == N / 2);
+  for (int i = 1; i < N; i += 2) {
+    if (auto spot = map.find(names[i]); spot == map.end() || spot->_n != i) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+
+  // Finish the expansion explicitly.
+  map.expand();
+  n = 0;
+  for (int i = 1; i < N; i += 2) {
+    if (map.find(names[i]) != map.end()) {
+      ++n;
+    }
+  }
+  REQUIRE(n == N / 2);
+
+  map.apply([](Thing *thing) { delete thing; });
+  map.clear();
+  REQUIRE(map.count() == 0);
+  map.insert(new Thing("bob"sv));
+  REQUIRE(map.find("bob"sv) != map.end());
+  map.apply([](Thing *thing) { delete thing; });
+}
+
+TEST_CASE("IntrusiveHashMap Cached Hash", "[IntrusiveHashMap]")
+{
+  static_assert(CachedMap::HASH_CACHE_P);
+  static_assert(CachedMap::MULTIPLY_SHIFT_P);
+  static_assert(!Map::HASH_CACHE_P);
+  static_assert(!Map::MULTIPLY_SHIFT_P);
+
+  CachedMap map;
+  constexpr int N = 1000;
+  std::vector<std::string> names;
+  names.reserve(N);
+  for (int i = 0; i < N; ++i) {
+    swoc::bwprint(names.emplace_back(), "name {}", i);
+    map.insert(new CachedThing(names.back(), i));
+  }
+  REQUIRE(map.count() == N);
+  REQUIRE(map.bucket_count() > CachedMap::DEFAULT_BUCKET_COUNT);
+
+  bool miss_p = false;
+  for (auto &thing : map) {
+    if (thing._hash != CachedThingMapDescriptor::hash_of(thing._payload)) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+
+  CachedThingMapDescriptor::_equal_count = 0;
+  for (int i = 0; i < N; ++i) {
+    if (auto spot = map.find(names[i]); spot == map.end() || spot->_n != i) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+  // Only the matching element is compared.
+  REQUIRE(CachedThingMapDescriptor::_equal_count == N);
+
+  CachedThingMapDescriptor::_equal_count = 0;
+  for (int i = N; i < 2 * N; ++i) {
+    std::string name;
+    if (map.find(swoc::bwprint(name, "name {}", i)) != map.end()) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+  REQUIRE(CachedThingMapDescriptor::_equal_count == 0);
+
+  // Check the buckets are still correct after erasing.
+  for (int i = 0; i < N; i += 3) {
+    CachedThing *thing = map.find(names[i]);
+    REQUIRE(map.erase(thing));
+    delete thing;
+  }
+  for (int i = 0; i < N; ++i) {
+    if ((map.find(names[i]) == map.end()) != (i % 3 == 0)) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+
+  map.apply([](CachedThing *thing) { delete thing; });
+}
+
+TEST_CASE("IntrusiveHashMap Stats", "[IntrusiveHashMap]")
+{
+  Map map;
+  auto stats = map.stats();
+  REQUIRE(stats._count == 0);
+  REQUIRE(stats._bucket_count == map.bucket_count());
+  REQUIRE(stats._histogram[0] == map.bucket_count());
+  REQUIRE(stats._expansions == 0);
+
+  constexpr int N = 500;
+  std::vector<std::string> names;
+  names.reserve(N);
+  for (int i = 0; i < N; ++i) {
+    swoc::bwprint(names.emplace_back(), "name {}", i);
+    map.insert(new Thing(names.back(), i));
+  }
+  // Duplicates do not make a bucket mixed.
+  map.insert(new Thing("dup"sv, 1));
+  map.insert(new Thing("dup"sv, 2));
+
+  stats = map.stats();
+  REQUIRE(stats._count == N + 2);
+  REQUIRE(stats._bucket_count == map.bucket_count());
+  REQUIRE(stats._expansions > 0);
+  REQUIRE(stats._active_count <= stats._bucket_count);
+  REQUIRE(stats._mixed_count <= stats._active_count);
+  REQUIRE(stats._max_length >= 2);
+  REQUIRE(stats._hit_probes >= 1.0);
+  REQUIRE(stats._miss_probes == double(N + 2) / map.bucket_count());
+  size_t n_buckets = 0;
+  for (auto n : stats._histogram) {
+    n_buckets += n;
+  }
+  size_t n_active = n_buckets - stats._histogram[0];
+  REQUIRE(n_buckets == stats._bucket_count);
+  REQUIRE(n_active == stats._active_count);
+
+  std::string text;
+  swoc::bwprint(text, "{}", stats);
+  REQUIRE(swoc::TextView(text).starts_with("count=502 buckets="));
+  REQUIRE(text.find("histogram=[") != std::string::npos);
+  REQUIRE(text.back() == ']');
+
+  // Erasing updates the bucket counts, including elements that are not first in the bucket.
+  auto r = map.equal_range("dup"sv);
+  std::vector<Thing *> dups;
+  for (auto &thing : r) {
+    dups.push_back(&thing);
+  }
+  map.erase(r);
+  for (auto thing : dups) {
+    delete thing;
+  }
+  REQUIRE(map.find("dup"sv) == map.end());
+  for (int i = 0; i < N; i += 2) {
+    Thing *thing = map.find(names[i]);
+    map.erase(thing);
+    delete thing;
+  }
+  stats        = map.stats();
+  size_t total = 0;
+  for (size_t i = 1; i < stats._histogram.size() - 1; ++i) {
+    total += i * stats._histogram[i];
+  }
+  REQUIRE(stats._count == N / 2);
+  REQUIRE(total <= stats._count);
+  REQUIRE(stats._max_length < size_t(N / 2));
+
+  map.apply([](Thing *thing) { delete thing; });
+  map.clear();
+  stats = map.stats();
+  REQUIRE(stats._count == 0);
+  REQUIRE(stats._active_count == 0);
+}
+
+TEST_CASE("IntrusiveHashMap Bulk", "[IntrusiveHashMap]")
+{
+  constexpr int N = 2000;
+  std::vector<std::string> names;
+  std::vector<Thing *> things;
+  names.reserve(N);
+  for (int i = 0; i < N; ++i) {
+    swoc::bwprint(names.emplace_back(), "name {}", i);
+    things.push_back(new Thing(names.back(), i));
+  }
+
+  Map map;
+  map.reserve(N);
+  REQUIRE(map.bucket_count() * map.get_expansion_limit() >= N);
+  auto nb = map.bucket_count();
+  map.reserve(N / 2); // never shrinks.
+  REQUIRE(map.bucket_count() == nb);
+  for (auto thing : things) {
+    map.insert(thing);
+  }
+  REQUIRE(map.count() == N);
+  REQUIRE(map.bucket_count() == nb); // No expansion after the reserve.
+  REQUIRE(map.stats()._expansions == 1);
+  map.clear();
+
+  // Bulk insert, with some duplicates that must stay in order.
+  for (int i = 0; i < 10; ++i) {
+    things.push_back(new Thing("dup"sv, i));
+  }
+  Map bulk;
+  bulk.insert(things.begin(), things.end());
+  REQUIRE(bulk.count() == N + 10);
+  REQUIRE(bulk.stats()._expansions == 1);
+  REQUIRE(bulk.bucket_count() * bulk.get_expansion_limit() >= N + 10);
+  bool miss_p = false;
+  for (int i = 0; i < N; ++i) {
+    if (auto spot = bulk.find(names[i]); spot == bulk.end() || spot->_n != i) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+  int n = 0;
+  for (auto &thing : bulk.equal_range("dup"sv)) {
+    miss_p = miss_p || thing._n != n++;
+  }
+  REQUIRE(miss_p == false);
+  REQUIRE(n == 10);
+
+  // Bulk insert in to a non-empty map with incremental expansion in progress.
+  Map more;
+  more.set_incremental_expansion(true);
+  for (int i = 0; i < N / 2; ++i) {
+    more.insert(things[i]);
+  }
+  more.insert(things.begin() + N / 2, things.end());
+  REQUIRE(more.count() == N + 10);
+  for (int i = 0; i < N; ++i) {
+    if (auto spot = more.find(names[i]); spot == more.end() || spot->_n != i) {
+      miss_p = true;
+    }
+  }
+  REQUIRE(miss_p == false);
+  more.clear();
+
+  // Manual policy does not expand.
+  Map manual;
+  manual.set_expansion_policy(Map::MANUAL);
+  nb = manual.bucket_count();
+  manual.insert(things.begin(), things.end());
+  REQUIRE(manual.bucket_count() == nb);
+  REQUIRE(manual.count() == N + 10);
+  REQUIRE(manual.find(names[N - 1]) != manual.end());
+
+  manual.apply([](Thing *thing) { delete thing; });
+}
+
 TEST_CASE("IntrusiveHashMap Utilities", "[IntrusiveHashMap]") {
 }
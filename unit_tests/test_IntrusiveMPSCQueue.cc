@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Apache Software Foundation 2019
+/** @file
+
+    IntrusiveMPSCQueue unit tests.
+*/
+
+#include <thread>
+#include <vector>
+
+#include "swoc/IntrusiveMPSCQueue.h"
+#include "catch.hpp"
+
+using swoc::IntrusiveMPSCQueue;
+
+namespace
+{
+struct Job {
+  int _producer;
+  int _seq;
+  Job *_next{nullptr};
+  Job *_prev{nullptr};
+
+  Job(int producer, int seq) : _producer(producer), _seq(seq) {}
+};
+
+using JobQueue = IntrusiveMPSCQueue<swoc::IntrusiveLinkage<Job>>;
+
+} // namespace
+
+TEST_CASE("IntrusiveMPSCQueue", "[libswoc][IntrusiveMPSCQueue]")
+{
+  JobQueue queue;
+  std::vector<Job> jobs;
+  for (int i = 0; i < 10; ++i) {
+    jobs.emplace_back(0, i);
+  }
+
+  REQUIRE(queue.empty());
+  REQUIRE(queue.take() == nullptr);
+  REQUIRE(queue.take_all().empty());
+
+  REQUIRE(queue.push(&jobs[0]) == true);
+  REQUIRE(queue.push(&jobs[1]) == false);
+  REQUIRE(queue.push(&jobs[2]) == false);
+  REQUIRE_FALSE(queue.empty());
+
+  auto batch = queue.take_all();
+  REQUIRE(queue.empty());
+  REQUIRE(batch.count() == 3);
+  REQUIRE(batch.head() == &jobs[0]);
+  REQUIRE(batch.tail() == &jobs[2]);
+  REQUIRE(batch.tail()->_next == nullptr);
+  int seq = 0;
+  for (auto const &job : batch) {
+    REQUIRE(job._seq == seq++);
+  }
+
+  // Items taken one at a time, with pushes in between.
+  for (int i = 3; i < 7; ++i) {
+    queue.push(&jobs[i]);
+  }
+  REQUIRE(queue.take() == &jobs[3]);
+  REQUIRE(queue.take() == &jobs[4]);
+  REQUIRE(queue.push(&jobs[7]) == true); // shared part is empty, even though the queue isn't.
+  REQUIRE(queue.take() == &jobs[5]);
+  // Remaining local items come before newly pushed items.
+  batch = queue.take_all();
+  REQUIRE(batch.count() == 2);
+  REQUIRE(batch.head() == &jobs[6]);
+  REQUIRE(batch.tail() == &jobs[7]);
+  REQUIRE(queue.empty());
+}
+
+TEST_CASE("IntrusiveMPSCQueue Threads", "[libswoc][IntrusiveMPSCQueue]")
+{
+  static constexpr int N_PRODUCERS = 4;
+  static constexpr int N_JOBS      = 20000;
+
+  JobQueue queue;
+  std::vector<std::vector<Job>> jobs(N_PRODUCERS);
+  for (int p = 0; p < N_PRODUCERS; ++p) {
+    jobs[p].reserve(N_JOBS);
+    for (int i = 0; i < N_JOBS; ++i) {
+      jobs[p].emplace_back(p, i);
+    }
+  }
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < N_PRODUCERS; ++p) {
+    threads.emplace_back([&, p]() -> void {
+      for (auto &job : jobs[p]) {
+        queue.push(&job);
+      }
+    });
+  }
+
+  // Each producer's jobs must arrive in order, and all exactly once.
+  std::vector<int> next(N_PRODUCERS, 0);
+  int total     = 0;
+  bool ordered  = true;
+  size_t n_take = 0;
+  while (total < N_PRODUCERS * N_JOBS) {
+    if (++n_take % 2) {
+      for (auto const &job : queue.take_all()) {
+        ordered = ordered && job._seq == next[job._producer]++;
+        ++total;
+      }
+    } else if (auto job = queue.take(); job) {
+      ordered = ordered && job->_seq == next[job->_producer]++;
+      ++total;
+    }
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(ordered);
+  REQUIRE(queue.empty());
+  for (int p = 0; p < N_PRODUCERS; ++p) {
+    REQUIRE(next[p] == N_JOBS);
+  }
+}
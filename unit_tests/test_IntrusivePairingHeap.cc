@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Apache Software Foundation 2019
+/** @file
+
+    IntrusivePairingHeap unit tests.
+*/
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "swoc/IntrusivePairingHeap.h"
+#include "catch.hpp"
+
+using swoc::IntrusivePairingHeap;
+
+namespace
+{
+struct Timer {
+  unsigned _expiry;
+  Timer *_child{nullptr};
+  Timer *_next{nullptr};
+  Timer *_prev{nullptr};
+
+  explicit Timer(unsigned expiry) : _expiry(expiry) {}
+
+  struct Descriptor {
+    static Timer *&
+    child_ptr(Timer *t)
+    {
+      return t->_child;
+    }
+    static Timer *&
+    next_ptr(Timer *t)
+    {
+      return t->_next;
+    }
+    static Timer *&
+    prev_ptr(Timer *t)
+    {
+      return t->_prev;
+    }
+    static unsigned
+    key_of(Timer *t)
+    {
+      return t->_expiry;
+    }
+    static bool
+    less(unsigned lhs, unsigned rhs)
+    {
+      return lhs < rhs;
+    }
+  };
+};
+
+using Heap = IntrusivePairingHeap<Timer::Descriptor>;
+
+// Take everything from @a heap, checking the order. Returns the number of elements taken.
+size_t
+drain(Heap &heap, bool &ordered_p)
+{
+  size_t n      = 0;
+  unsigned last = 0;
+  ordered_p     = true;
+  while (Timer *t = heap.take_top()) {
+    ordered_p = ordered_p && last <= t->_expiry && t->_next == nullptr && t->_prev == nullptr && t->_child == nullptr;
+    last      = t->_expiry;
+    ++n;
+  }
+  return n;
+}
+
+} // namespace
+
+TEST_CASE("IntrusivePairingHeap", "[libswoc][IntrusivePairingHeap]")
+{
+  Heap heap;
+  bool ordered_p;
+  REQUIRE(heap.empty());
+  REQUIRE(heap.top() == nullptr);
+  REQUIRE(heap.take_top() == nullptr);
+
+  std::vector<Timer> timers;
+  for (unsigned x : {50, 10, 40, 30, 20, 10}) {
+    timers.emplace_back(x);
+  }
+  for (auto &t : timers) {
+    heap.insert(&t);
+  }
+  REQUIRE(heap.count() == 6);
+  REQUIRE(heap.top()->_expiry == 10);
+
+  heap.erase(&timers[2]); // 40
+  REQUIRE(heap.count() == 5);
+  heap.erase(heap.top());
+  REQUIRE(heap.top()->_expiry == 10);
+  REQUIRE(heap.count() == 4);
+
+  timers[0]._expiry = 5; // decrease
+  heap.update(&timers[0]);
+  REQUIRE(heap.top() == &timers[0]);
+  timers[0]._expiry = 25; // increase
+  heap.update(&timers[0]);
+  REQUIRE(heap.top()->_expiry == 10);
+
+  Heap other;
+  std::vector<Timer> more{Timer{1}, Timer{100}};
+  other.insert(&more[0]).insert(&more[1]);
+  heap.merge(other);
+  REQUIRE(other.empty());
+  REQUIRE(other.count() == 0);
+  REQUIRE(heap.count() == 6);
+  REQUIRE(heap.top() == &more[0]);
+
+  Heap moved{std::move(heap)};
+  REQUIRE(heap.empty());
+  REQUIRE(drain(moved, ordered_p) == 6);
+  REQUIRE(ordered_p);
+  REQUIRE(moved.empty());
+}
+
+TEST_CASE("IntrusivePairingHeap Random", "[libswoc][IntrusivePairingHeap]")
+{
+  static constexpr unsigned N = 20000;
+  std::minstd_rand rng(13);
+  std::vector<Timer> timers;
+  timers.reserve(N);
+  Heap heap;
+  for (unsigned i = 0; i < N; ++i) {
+    heap.insert(&timers.emplace_back(rng() % 5000));
+  }
+  REQUIRE(heap.count() == N);
+
+  // Take some so the heap is not just a list of children of the root, then erase and update.
+  std::vector<Timer *> taken;
+  for (unsigned i = 0; i < N / 10; ++i) {
+    taken.push_back(heap.take_top());
+  }
+  REQUIRE(std::is_sorted(taken.begin(), taken.end(), [](Timer *lhs, Timer *rhs) { return lhs->_expiry < rhs->_expiry; }));
+
+  size_t erased = 0;
+  for (auto &t : timers) {
+    if (std::find(taken.begin(), taken.end(), &t) != taken.end()) {
+      continue;
+    }
+    if (rng() % 4 == 0) {
+      heap.erase(&t);
+      ++erased;
+    } else if (rng() % 4 == 0) {
+      t._expiry = rng() % 10000;
+      heap.update(&t);
+    }
+  }
+  REQUIRE(heap.count() == N - taken.size() - erased);
+
+  bool ordered_p;
+  REQUIRE(drain(heap, ordered_p) == N - taken.size() - erased);
+  REQUIRE(ordered_p);
+}
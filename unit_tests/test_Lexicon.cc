@@ -5,6 +5,11 @@
     Lexicon unit tests.
 */
 
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
 #include "swoc/Lexicon.h"
 #include "catch.hpp"
 
@@ -198,3 +203,131 @@ TEST_CASE("Lexicon Constructor 2", "[libts][Lexicon]")
   REQUIRE(v5["q"] == INVALID);
   REQUIRE(v5[C] == "Invalid");
 }
+
+TEST_CASE("StaticLexicon", "[libts][Lexicon][StaticLexicon]")
+{
+  enum class Method { NONE, GET, HEAD, POST, PUT, DELETE };
+  static constexpr auto Methods = swoc::make_static_lexicon<Method>({{Method::GET, "GET"},
+                                                                     {Method::HEAD, "HEAD"},
+                                                                     {Method::POST, "POST"},
+                                                                     {Method::PUT, "PUT"},
+                                                                     {Method::DELETE, "DELETE"},
+                                                                     {Method::DELETE, "REMOVE"}})
+                                    .set_default(Method::NONE)
+                                    .set_default("NONE");
+
+  // Verify the lookups are done at compile time.
+  static_assert(Methods["GET"] == Method::GET);
+  static_assert(Methods["post"] == Method::POST);
+  static_assert(Methods["Remove"] == Method::DELETE);
+  static_assert(Methods["PATCH"] == Method::NONE);
+  static_assert(Methods[Method::DELETE] == "DELETE");
+  static_assert(Methods[Method::NONE] == "NONE");
+  static_assert(Methods.count() == 5);
+
+  std::string name{"head"};
+  REQUIRE(Methods[name] == Method::HEAD);
+  REQUIRE(Methods[Method::PUT] == "PUT");
+  size_t n = 0;
+  for (auto const &[value, name] : Methods) {
+    REQUIRE(Methods[name] == value);
+    ++n;
+  }
+  REQUIRE(n == Methods.count());
+
+  // Case sensitive, no defaults, values not contiguous.
+  static constexpr auto Flags =
+    swoc::make_static_lexicon<Hex, false>({{A, "a"}, {C, "c"}, {E, "e"}, {INVALID, "invalid"}});
+  REQUIRE(Flags["c"] == C);
+  REQUIRE(Flags[E] == "e");
+  REQUIRE(Flags[INVALID] == "invalid");
+  REQUIRE_THROWS_AS(Flags["C"], std::domain_error);
+  REQUIRE_THROWS_AS(Flags[B], std::domain_error);
+  REQUIRE_THROWS_AS(Flags[static_cast<Hex>(-1)], std::domain_error);
+
+  // A large set, constructed at run time.
+  static constexpr size_t N = 500;
+  std::vector<std::string> names;
+  std::pair<int, std::string_view> items[N];
+  for (size_t i = 0; i < N; ++i) {
+    names.emplace_back("Name_" + std::to_string(i * 7));
+  }
+  for (size_t i = 0; i < N; ++i) {
+    items[i] = {int(i), names[i]};
+  }
+  swoc::StaticLexicon<int, N> big{items};
+  for (size_t i = 0; i < N; ++i) {
+    REQUIRE(big[names[i]] == int(i));
+    REQUIRE(big[int(i)] == names[i]);
+  }
+  REQUIRE_THROWS_AS(big["Name_1"], std::domain_error);
+
+  std::pair<int, std::string_view> dups[] = {{1, "one"}, {2, "ONE"}};
+  using Pairs = swoc::StaticLexicon<int, 2>;
+  REQUIRE_THROWS_AS(Pairs{dups}, std::invalid_argument);
+}
+
+TEST_CASE("Lexicon value index", "[libts][Lexicon]")
+{
+  // Values are looked up by index while dense, then by hash, then by index again as the gaps fill.
+  swoc::Lexicon<int> lex;
+  lex.set_default("none");
+  std::vector<std::string> names;
+  for (int i = 0; i < 200; ++i) {
+    names.emplace_back("v" + std::to_string(i));
+  }
+  auto check = [&](std::vector<int> const &defined) {
+    for (int v = -10; v < 210; ++v) {
+      bool found_p = std::find(defined.begin(), defined.end(), v) != defined.end();
+      REQUIRE(lex[v] == (found_p ? std::string_view(names[v]) : "none"));
+    }
+  };
+
+  std::vector<int> defined;
+  for (int v : {5, 6, 7, 3, 10}) {
+    lex.define(v, names[v], names[v] + "_2");
+    defined.push_back(v);
+    check(defined);
+  }
+  for (int v : {150, 0, 100}) { // sparse.
+    lex.define(v, names[v]);
+    defined.push_back(v);
+    check(defined);
+  }
+  for (int v = 1; v < 200; v += 2) { // fill in, dense again.
+    if (std::find(defined.begin(), defined.end(), v) == defined.end()) {
+      lex.define(v, names[v]);
+      defined.push_back(v);
+    }
+  }
+  check(defined);
+  REQUIRE(lex["v7_2"] == 7);
+  REQUIRE(lex[std::numeric_limits<int>::min()] == "none");
+
+  swoc::Lexicon<intmax_t> wide{{std::numeric_limits<intmax_t>::min(), "min"}, {std::numeric_limits<intmax_t>::max(), "max"}};
+  REQUIRE(wide[std::numeric_limits<intmax_t>::min()] == "min");
+  REQUIRE(wide[std::numeric_limits<intmax_t>::max()] == "max");
+
+  // Descending, the index grows at the front.
+  swoc::Lexicon<int> down;
+  down.set_default("none");
+  for (int v = 199; v >= 0; --v) {
+    down.define(v, names[v]);
+  }
+  bool valid_p = true;
+  for (int v = -10; v < 210; ++v) {
+    valid_p = valid_p && down[v] == (0 <= v && v < 200 ? std::string_view(names[v]) : "none");
+  }
+  REQUIRE(valid_p);
+
+  // Growing at the front must stop at the minimum value.
+  constexpr auto MIN = std::numeric_limits<intmax_t>::min();
+  swoc::Lexicon<intmax_t> low;
+  low.set_default("none");
+  low.define(MIN + 2, "two").define(MIN + 1, "one").define(MIN, "zero");
+  REQUIRE(low[MIN] == "zero");
+  REQUIRE(low[MIN + 1] == "one");
+  REQUIRE(low[MIN + 2] == "two");
+  REQUIRE(low[MIN + 3] == "none");
+  REQUIRE(low[std::numeric_limits<intmax_t>::max()] == "none");
+}
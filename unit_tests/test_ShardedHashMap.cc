@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Apache Software Foundation 2019
+/** @file
+
+    ShardedHashMap unit tests.
+*/
+
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <bitset>
+
+#include "swoc/ShardedHashMap.h"
+#include "swoc/bwf_base.h"
+#include "catch.hpp"
+
+using swoc::ShardedHashMap;
+
+using namespace std::literals;
+
+namespace
+{
+struct Thing {
+  std::string _payload;
+  int _n{0};
+  std::atomic<int> _hits{0};
+
+  Thing(std::string_view text, int x) : _payload(text), _n(x) {}
+
+  Thing *_next{nullptr};
+  Thing *_prev{nullptr};
+};
+
+struct ThingMapDescriptor {
+  static Thing *&
+  next_ptr(Thing *thing)
+  {
+    return thing->_next;
+  }
+  static Thing *&
+  prev_ptr(Thing *thing)
+  {
+    return thing->_prev;
+  }
+  static std::string_view
+  key_of(Thing *thing)
+  {
+    return thing->_payload;
+  }
+  static size_t
+  hash_of(std::string_view s)
+  {
+    return std::hash<std::string_view>{}(s);
+  }
+  static bool
+  equal(std::string_view const &lhs, std::string_view const &rhs)
+  {
+    return lhs == rhs;
+  }
+};
+
+using Map = ShardedHashMap<ThingMapDescriptor, 8>;
+
+} // namespace
+
+TEST_CASE("ShardedHashMap", "[libswoc][ShardedHashMap]")
+{
+  Map map;
+  map.insert(new Thing("bob", 1));
+  map.insert(new Thing("dave", 2));
+  REQUIRE(map.count() == 2);
+  REQUIRE(map.find("bob"sv) != nullptr);
+  REQUIRE(map.find("bob"sv)->_n == 1);
+  REQUIRE(map.find("persia"sv) == nullptr);
+
+  int n = 0;
+  REQUIRE(map.find("dave"sv, [&](Thing &thing) { n = thing._n; }));
+  REQUIRE(n == 2);
+  REQUIRE_FALSE(map.find("persia"sv, [&](Thing &) { n = 0; }));
+  REQUIRE(n == 2);
+
+  Thing *thing = map.erase("bob"sv);
+  REQUIRE(thing != nullptr);
+  REQUIRE(thing->_payload == "bob"sv);
+  REQUIRE(map.erase(thing) == false);
+  delete thing;
+  REQUIRE(map.count() == 1);
+  REQUIRE(map.erase("bob"sv) == nullptr);
+
+  map.apply([](Thing *thing) { delete thing; });
+  map.clear();
+  REQUIRE(map.count() == 0);
+
+  // The shard index is in range for any hash value.
+  bool valid_p = true;
+  for (size_t h : {size_t(0), size_t(1), ~size_t(0), size_t(1) << 63, size_t(0x123456789abcdef)}) {
+    valid_p = valid_p && Map::shard_index(h) < Map::SHARD_COUNT;
+  }
+  REQUIRE(valid_p);
+  // Small values, such as from an identity hash, are spread across the shards.
+  std::bitset<Map::SHARD_COUNT> used;
+  for (size_t h = 0; h < 64; ++h) {
+    used[Map::shard_index(h)] = true;
+  }
+  REQUIRE(used.all());
+}
+
+TEST_CASE("ShardedHashMap Threads", "[libswoc][ShardedHashMap]")
+{
+  static constexpr int N_THREAD = 8;
+  static constexpr int N_ITEM   = 2000;
+
+  Map map;
+  map.set_incremental_expansion(true);
+
+  std::vector<std::thread> threads;
+  std::atomic<int> misses{0};
+  for (int t = 0; t < N_THREAD; ++t) {
+    threads.emplace_back([&, t]() -> void {
+      std::string name;
+      for (int i = 0; i < N_ITEM; ++i) {
+        swoc::bwprint(name, "{}-{}", t, i);
+        map.insert(new Thing(name, i));
+        // Look up an item inserted (and not removed) by this thread, and one that may have been inserted by another thread.
+        if (!map.find(swoc::bwprint(name, "{}-{}", t, (i / 2) & ~3), [](Thing &thing) { ++thing._hits; })) {
+          ++misses;
+        }
+        map.find(swoc::bwprint(name, "{}-{}", (t + 1) % N_THREAD, i), [](Thing &thing) { ++thing._hits; });
+        // Remove every fourth item.
+        if (i % 4 == 3) {
+          delete map.erase(swoc::bwprint(name, "{}-{}", t, i));
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  REQUIRE(misses == 0);
+  REQUIRE(map.count() == N_THREAD * (N_ITEM - N_ITEM / 4));
+  int n       = 0;
+  bool miss_p = false;
+  std::string name;
+  for (int t = 0; t < N_THREAD; ++t) {
+    for (int i = 0; i < N_ITEM; ++i) {
+      if ((map.find(swoc::bwprint(name, "{}-{}", t, i)) == nullptr) != (i % 4 == 3)) {
+        miss_p = true;
+      }
+    }
+  }
+  REQUIRE(miss_p == false);
+  map.apply([&](Thing &thing) { n += thing._hits > 0; });
+  REQUIRE(n > 0);
+  map.apply([](Thing *thing) { delete thing; });
+}
@@ -18,12 +18,18 @@
     limitations under the License.
 */
 
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "swoc/TextView.h"
+#include "swoc/TextTokenizer.h"
 #include "catch.hpp"
 
 using swoc::TextView;
@@ -395,6 +401,391 @@ TEST_CASE("TextView Affixes", "[libswoc][TextView]")
   REQUIRE(ctv2 == ctv3);
 };
 
+TEST_CASE("TextView CharSet", "[libswoc][TextView][CharSet]")
+{
+  using swoc::CharSet;
+  static constexpr CharSet DELIM{",; \t"};
+  static_assert(DELIM.contains(','));
+  static_assert(DELIM.contains('\t'));
+  static_assert(!DELIM.contains('a'));
+  static_assert(!CharSet{}.contains('\0'));
+  static_assert(CharSet{}.add('\xff').contains('\xff'));
+  static_assert(!CharSet{"\x7f"}.contains('\xff'));
+
+  TextView src{" \talpha, beta;gamma ,;delta\t "};
+  TextView tv{src};
+  REQUIRE(tv.trim(DELIM) == "alpha, beta;gamma ,;delta");
+  REQUIRE(TextView{src}.ltrim(DELIM) == "alpha, beta;gamma ,;delta\t ");
+  REQUIRE(TextView{src}.rtrim(DELIM) == " \talpha, beta;gamma ,;delta");
+  REQUIRE(tv.find_first_of(DELIM) == 5);
+  REQUIRE(tv.find_last_of(DELIM) == tv.find_last_of(",; \t"));
+  REQUIRE(tv.find_first_of(CharSet{"xyz"}) == TextView::npos);
+  REQUIRE(tv.find_first_of("lp") == 1); // string overloads are still available.
+
+  // Results must match the delimiter string overloads.
+  TextView a{tv}, b{tv};
+  while (a || b) {
+    REQUIRE(a.take_prefix_at(DELIM) == b.take_prefix_at(",; \t"));
+    REQUIRE(a == b);
+  }
+  a = b = tv;
+  while (a || b) {
+    REQUIRE(a.take_suffix_at(DELIM) == b.take_suffix_at(",; \t"));
+    REQUIRE(a == b);
+  }
+  a = tv;
+  REQUIRE(a.split_prefix_at(DELIM) == "alpha");
+  REQUIRE(a.split_suffix_at(DELIM) == "delta");
+  REQUIRE(a == " beta;gamma ,");
+  REQUIRE(a.prefix_at(DELIM).empty());
+  REQUIRE(a.suffix_at(DELIM).empty());
+  REQUIRE(a.remove_prefix_at(DELIM) == "beta;gamma ,");
+  REQUIRE(a.prefix_at(DELIM) == "beta");
+  REQUIRE(a.remove_suffix_at(DELIM) == "beta;gamma ");
+  REQUIRE(a.split_prefix_at(CharSet{"x"}).empty());
+  REQUIRE(a == "beta;gamma ");
+
+  // Usable as a predicate.
+  a = tv;
+  REQUIRE(a.take_prefix_if(DELIM) == "alpha");
+}
+
+TEST_CASE("TextView Scanning", "[libswoc][TextView][scan]")
+{
+  using swoc::CharSet;
+  using swoc::detail::ScanISA;
+  static constexpr TextView DELIMITERS{",; \t\xa0\xff"};
+  static constexpr CharSet DELIM{DELIMITERS};
+
+  // Reference implementations.
+  auto ref_first = [](TextView tv, bool in) -> size_t {
+    for (size_t i = 0; i < tv.size(); ++i) {
+      if (DELIM(tv[i]) == in) {
+        return i;
+      }
+    }
+    return TextView::npos;
+  };
+  auto ref_last = [](TextView tv, bool in) -> size_t {
+    for (size_t i = tv.size(); i > 0; --i) {
+      if (DELIM(tv[i - 1]) == in) {
+        return i - 1;
+      }
+    }
+    return TextView::npos;
+  };
+
+  // Pseudo-random text with varying delimiter density, including high bit characters.
+  std::string text;
+  uint32_t x = 0x12345678;
+  for (unsigned i = 0; i < 4096; ++i) {
+    x = x * 1103515245 + 12345;
+    auto r = (x >> 16);
+    text += (r % 11 == 0) ? DELIMITERS[r % DELIMITERS.size()] : char('a' + r % 26 + (r % 7 == 0 ? 0x60 : 0));
+  }
+
+  auto original = swoc::detail::scan_isa();
+  for (auto isa : {ScanISA::SCALAR, ScanISA::SSE2, ScanISA::SSSE3, ScanISA::AVX2}) {
+    auto actual = swoc::detail::scan_isa(isa);
+    REQUIRE(actual <= isa);
+    // Every length and alignment near the vector widths, then longer runs.
+    for (size_t off = 0; off < 40; ++off) {
+      for (size_t n = 0; n < 100; ++n) {
+        TextView tv{text.data() + off * 37, n};
+        REQUIRE(tv.find_first_of(DELIM) == ref_first(tv, true));
+        REQUIRE(tv.find_last_of(DELIM) == ref_last(tv, true));
+        REQUIRE(swoc::detail::find_first_not_of(tv.data(), tv.size(), DELIM) == ref_first(tv, false));
+        REQUIRE(swoc::detail::find_last_not_of(tv.data(), tv.size(), DELIM) == ref_last(tv, false));
+        REQUIRE(swoc::detail::find_first_of(tv.data(), tv.size(), ",;"sv) == tv.std::string_view::find_first_of(",;"));
+        REQUIRE(swoc::detail::find_last_of(tv.data(), tv.size(), ",;"sv) == tv.std::string_view::find_last_of(",;"));
+        REQUIRE(swoc::detail::rfind(tv.data(), tv.size(), ';') == tv.std::string_view::rfind(';'));
+        for (size_t k = 0, spot = ref_first(tv, true), cspot = tv.find(';'); k < 6; ++k) {
+          REQUIRE(swoc::detail::find_nth_of(tv.data(), tv.size(), DELIM, k) == spot);
+          REQUIRE(swoc::detail::find_nth(tv.data(), tv.size(), ';', k) == cspot);
+          if (spot != TextView::npos) {
+            auto next = ref_first(tv.substr(spot + 1), true);
+            spot      = next == TextView::npos ? next : spot + 1 + next;
+          }
+          cspot = cspot == TextView::npos ? cspot : tv.find(';', cspot + 1);
+        }
+      }
+    }
+    TextView all{text};
+    REQUIRE(all.find_first_of(CharSet{"\x01"}) == TextView::npos);
+    REQUIRE(all.find_last_of(CharSet{"\x01"}) == TextView::npos);
+    REQUIRE(TextView{"   \t  "}.trim(DELIM).empty());
+    REQUIRE(TextView{text}.ltrim(CharSet{"abcdefghijklmnopqrstuvwxyz"}).size() == all.size() - all.std::string_view::find_first_not_of("abcdefghijklmnopqrstuvwxyz"));
+
+    // Token splitting must match the standard library.
+    TextView a{text}, b{text};
+    while (a) {
+      auto n = b.std::string_view::find_first_of(DELIMITERS);
+      REQUIRE(a.take_prefix_at(DELIM) == b.take_prefix(n));
+    }
+    a = b = text;
+    while (a) {
+      auto n = b.std::string_view::find_last_of(DELIMITERS);
+      REQUIRE(a.take_suffix_at(DELIMITERS) == b.take_suffix(n));
+    }
+  }
+  swoc::detail::scan_isa(original);
+}
+
+TEST_CASE("TextView case folding", "[libswoc][TextView][scan][nocase]")
+{
+  using swoc::detail::ScanISA;
+
+  // Reference implementations.
+  auto lower    = [](char c) -> int { return ('A' <= c && c <= 'Z') ? c + ('a' - 'A') : static_cast<unsigned char>(c); };
+  auto ref_cmp  = [&](char const *lhs, char const *rhs, size_t n) -> int {
+    for (size_t i = 0; i < n; ++i) {
+      if (int d = lower(lhs[i]) - lower(rhs[i]); d) {
+        return d;
+      }
+    }
+    return 0;
+  };
+  auto ref_find = [&](TextView tv, TextView pattern) -> size_t {
+    for (size_t i = 0; i + pattern.size() <= tv.size(); ++i) {
+      if (0 == ref_cmp(tv.data() + i, pattern.data(), pattern.size())) {
+        return i;
+      }
+    }
+    return TextView::npos;
+  };
+
+  // Mostly letters in both cases, with the characters adjacent to the letter ranges and high bit characters.
+  static constexpr TextView OTHERS{"@[`{\xc1\xe1\x00-", 8};
+  std::string text;
+  uint32_t x = 0x87654321;
+  for (unsigned i = 0; i < 4096; ++i) {
+    x = x * 1103515245 + 12345;
+    auto r = (x >> 16);
+    text += (r % 13 == 0) ? OTHERS[r % OTHERS.size()] : char((r % 3 ? 'a' : 'A') + r % 4);
+  }
+  std::string folded{text};
+  for (auto &c : folded) {
+    c = ('a' <= c && c <= 'z') ? c - ('a' - 'A') : ('A' <= c && c <= 'Z') ? c + ('a' - 'A') : c;
+  }
+
+  auto original = swoc::detail::scan_isa();
+  for (auto isa : {ScanISA::SCALAR, ScanISA::SSE2, ScanISA::SSSE3, ScanISA::AVX2}) {
+    swoc::detail::scan_isa(isa);
+    for (size_t off = 0; off < 40; ++off) {
+      for (size_t n = 0; n < 100; ++n) {
+        TextView tv{text.data() + off * 37, n};
+        TextView fv{folded.data() + off * 37, n};
+        TextView other{text.data() + off * 41, n};
+        REQUIRE(swoc::detail::casecmp(tv.data(), fv.data(), n) == 0);
+        REQUIRE(swoc::detail::casecmp(tv.data(), other.data(), n) == ref_cmp(tv.data(), other.data(), n));
+        REQUIRE(strcaseeq(tv, fv));
+        REQUIRE(strcaseeq(tv, other) == (0 == ref_cmp(tv.data(), other.data(), n)));
+        REQUIRE(TextView{text}.starts_with_nocase(TextView{folded}.prefix(n)));
+        REQUIRE(TextView{text}.ends_with_nocase(TextView{folded}.suffix(n)));
+        REQUIRE(TextView{folded}.substr(off * 37).starts_with_nocase(tv));
+        // Search for the pattern which is known to be present, and some that aren't.
+        TextView all{text};
+        auto pattern = TextView{folded}.substr(off * 53 + n, (n % 17) + 1);
+        REQUIRE(all.find_nocase(pattern) == ref_find(all, pattern));
+        REQUIRE(all.find_nocase(pattern, n) == ref_find(all.substr(n), pattern) + n);
+        REQUIRE(tv.find_nocase(other.prefix(n % 5)) == ref_find(tv, other.prefix(n % 5)));
+      }
+    }
+  }
+  swoc::detail::scan_isa(original);
+
+  TextView tv{"Content-Type: text/HTML"};
+  REQUIRE(tv.find_nocase("content") == 0);
+  REQUIRE(tv.find_nocase("html") == 19);
+  REQUIRE(tv.find_nocase("HTML", 20) == TextView::npos);
+  REQUIRE(tv.find_nocase("T") == 3);
+  REQUIRE(tv.find_nocase(":") == 12);
+  REQUIRE(tv.find_nocase("") == 0);
+  REQUIRE(tv.find_nocase("", tv.size()) == tv.size());
+  REQUIRE(tv.find_nocase("x", tv.size() + 1) == TextView::npos);
+  REQUIRE(tv.find_nocase("text/htmlx") == TextView::npos);
+  REQUIRE(tv.find_nocase("cONTENT-tYPE: TEXT/html") == 0);
+  REQUIRE(tv.find_nocase("cONTENT-tYPE: TEXT/html!") == TextView::npos);
+  REQUIRE(strcasecmp(TextView{"a\0b", 3}, TextView{"A\0c", 3}) < 0);
+  REQUIRE(strcasecmp("abc"_tv, "ABD"_tv) < 0);
+  REQUIRE(strcasecmp("abD"_tv, "ABc"_tv) > 0);
+  REQUIRE(strcasecmp("[bc"_tv, "{BC"_tv) < 0);
+  REQUIRE(strcaseeq("Host"_tv, "HOST"_tv));
+  REQUIRE_FALSE(strcaseeq("Host"_tv, "HOSTS"_tv));
+  REQUIRE_FALSE(strcaseeq("@"_tv, "`"_tv));
+}
+
+TEST_CASE("TextTokenizer", "[libswoc][TextView][TextTokenizer]")
+{
+  using swoc::TextTokenizer;
+  using tokens = std::vector<TextView>;
+  auto all     = [](TextTokenizer tok) {
+    tokens zret;
+    for (auto token : tok) {
+      zret.push_back(token);
+    }
+    return zret;
+  };
+
+  REQUIRE(all(TextTokenizer::lines("")).empty());
+  REQUIRE(all(TextTokenizer::lines("one\ntwo\r\n\nfour")) == tokens{"one", "two", "", "four"});
+  REQUIRE(all(TextTokenizer::lines("one\ntwo\n")) == tokens{"one", "two"});
+  REQUIRE(all(TextTokenizer::lines("\n")) == tokens{""});
+
+  REQUIRE(all(TextTokenizer::fields("", ',')).empty());
+  REQUIRE(all(TextTokenizer::fields(",", ',')) == tokens{"", ""});
+  REQUIRE(all(TextTokenizer::fields("a,b;;c,", swoc::CharSet{",;"})) == tokens{"a", "b", "", "c", ""});
+  REQUIRE(all(TextTokenizer::fields("  a b \t c  ", swoc::CharSet{" \t"}, true)) == tokens{"a", "b", "c"});
+  REQUIRE(all(TextTokenizer::fields("   ", ' ', true)).empty());
+
+  REQUIRE(all(TextTokenizer::quoted("")).empty());
+  REQUIRE(all(TextTokenizer::quoted(R"(a,"b,c",,"")")) == tokens{"a", "b,c", "", ""});
+  REQUIRE(all(TextTokenizer::quoted(R"("say ""hi""",x)")) == tokens{R"(say ""hi"")", "x"});
+  REQUIRE(all(TextTokenizer::quoted(R"("a\"b"junk;c;"open)", ';', '"', '\\')) == tokens{R"(a\"b)", "c", "open"});
+
+  // Skipping must be the same as extracting.
+  std::string text;
+  std::mt19937 rng(0x5EED);
+  for (int i = 0; i < 2000; ++i) {
+    auto r = rng() % 16;
+    text += r < 2 ? '\n' : r < 4 ? ',' : r < 5 ? '"' : char('a' + r);
+  }
+  for (size_t n = 0; n < 200; n += 7) {
+    auto check = [&](TextTokenizer tok) {
+      TextTokenizer ref{tok};
+      for (size_t i = 0; i < n; ++i) {
+        ref.next();
+      }
+      tok.skip(n);
+      REQUIRE(bool(tok) == bool(ref));
+      REQUIRE(tok.remaining().data() == ref.remaining().data());
+      REQUIRE(tok.next() == ref.next());
+    };
+    check(TextTokenizer::lines(text));
+    check(TextTokenizer::fields(text, ','));
+    check(TextTokenizer::fields(text, swoc::CharSet{",\n"}));
+    check(TextTokenizer::fields(text, ',', true));
+    check(TextTokenizer::quoted(text));
+  }
+
+  auto tok = TextTokenizer::fields("a,b,c", ',');
+  REQUIRE(tok.skip(2).next() == "c");
+  REQUIRE(tok.empty());
+  REQUIRE(tok.skip(1).next().empty());
+}
+
+TEST_CASE("TextView Scanning long runs", "[libswoc][TextView][scan]")
+{
+  using swoc::CharSet;
+  using swoc::detail::ScanISA;
+  static constexpr TextView SEPARATORS{" ,\n"};
+  static constexpr CharSet SEP_SET{SEPARATORS};
+
+  // Log like text - long runs between separators, unlike the dense text in the other scanning tests.
+  std::string text;
+  while (text.size() < (1 << 12)) {
+    text += "GET /a/fairly/long/path/to/some/resource.html?query=value&other=thing HTTP/1.1 200 4312\r\n";
+  }
+
+  auto original = swoc::detail::scan_isa();
+  for (auto isa : {ScanISA::SCALAR, ScanISA::SSE2, ScanISA::SSSE3, ScanISA::AVX2}) {
+    swoc::detail::scan_isa(isa);
+    TextView a{text}, b{text};
+    while (a) {
+      auto n = b.std::string_view::find_first_of(SEPARATORS);
+      REQUIRE(a.take_prefix_at(SEP_SET) == b.take_prefix(n));
+    }
+    a = b = text;
+    while (a) {
+      auto n = b.std::string_view::find_last_of(SEPARATORS);
+      REQUIRE(a.take_suffix_at(SEP_SET) == b.take_suffix(n));
+    }
+    a = b = text;
+    while (a) {
+      auto n = b.std::string_view::find_first_of("\r\n");
+      REQUIRE(a.take_prefix_at("\r\n"sv) == b.take_prefix(n));
+    }
+  }
+  swoc::detail::scan_isa(original);
+}
+
+// Normally there's no point in running the performance tests, but it's worth keeping the code
+// for when additional testing needs to be done.
+#if 0
+TEST_CASE("TextView Scanning performance", "[libswoc][TextView][scan][performance]")
+{
+  using swoc::CharSet;
+  using swoc::detail::ScanISA;
+  static constexpr int N_LOOPS = 2000;
+  static constexpr TextView SEPARATORS{" ,\n"};
+  static constexpr CharSet SEP_SET{SEPARATORS};
+
+  // Log like text - long runs between separators.
+  std::string text;
+  while (text.size() < (1 << 16)) {
+    text += "GET /a/fairly/long/path/to/some/resource.html?query=value&other=thing HTTP/1.1 200 4312\n";
+  }
+
+  auto time = [&](char const *name, auto &&f) {
+    size_t count = 0;
+    auto start   = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < N_LOOPS; ++i) {
+      count += f();
+    }
+    auto delta = std::chrono::high_resolution_clock::now() - start;
+    std::cout << name << " " << std::chrono::duration_cast<std::chrono::microseconds>(delta).count() << "us" << std::endl;
+    return count;
+  };
+
+  auto baseline = time("std::string_view tokens", [&]() {
+    size_t n = 0;
+    for (std::string_view tv{text}; !tv.empty(); ++n) {
+      auto idx = tv.find_first_of(SEPARATORS);
+      tv.remove_prefix(idx == tv.npos ? tv.size() : idx + 1);
+    }
+    return n;
+  });
+  auto rbaseline = time("std::string_view reverse tokens", [&]() {
+    size_t n = 0;
+    for (std::string_view tv{text}; !tv.empty(); ++n) {
+      auto idx = tv.find_last_of(SEPARATORS);
+      tv.remove_suffix(idx == tv.npos ? tv.size() : tv.size() - idx);
+    }
+    return n;
+  });
+
+  auto original = swoc::detail::scan_isa();
+  for (auto isa : {ScanISA::SCALAR, ScanISA::SSE2, ScanISA::SSSE3, ScanISA::AVX2}) {
+    if (swoc::detail::scan_isa(isa) != isa) {
+      continue;
+    }
+    std::cout << "ISA level " << int(isa) << std::endl;
+    REQUIRE(baseline == time("  TextView tokens (CharSet)", [&]() {
+              size_t n = 0;
+              for (TextView tv{text}; tv; ++n) {
+                tv.take_prefix_at(SEP_SET);
+              }
+              return n;
+            }));
+    REQUIRE(rbaseline == time("  TextView reverse tokens (CharSet)", [&]() {
+              size_t n = 0;
+              for (TextView tv{text}; tv; ++n) {
+                tv.take_suffix_at(SEP_SET);
+              }
+              return n;
+            }));
+    time("  TextView lines (2 chars)", [&]() {
+      size_t n = 0;
+      for (TextView tv{text}; tv; ++n) {
+        tv.take_prefix_at("\r\n"sv);
+      }
+      return n;
+    });
+  }
+  swoc::detail::scan_isa(original);
+}
+#endif
+
 TEST_CASE("TextView Formatting", "[libswoc][TextView]")
 {
   TextView a("01234567");
@@ -536,6 +927,135 @@ TEST_CASE("TextView Conversions", "[libswoc][TextView]")
   REQUIRE(true == fcmp(6.789e5, swoc::svtod("6.789E+5")));
 }
 
+TEST_CASE("TextView svto_radix decimal", "[libswoc][TextView][svtoi]")
+{
+  static constexpr auto MAX = std::numeric_limits<uintmax_t>::max();
+  // Reference, a digit at a time with clamping.
+  auto ref = [](TextView text, size_t &n) -> uintmax_t {
+    uintmax_t zret = 0;
+    for (n = 0; n < text.size() && isdigit(text[n]); ++n) {
+      unsigned d = text[n] - '0';
+      zret = (zret > (MAX - d) / 10) ? MAX : zret * 10 + d;
+    }
+    return zret;
+  };
+
+  std::mt19937_64 rng(0x5EED);
+  // All digit counts across chunk boundaries, with various terminators including the characters
+  // adjacent to the digits and characters that carry in the digit check.
+  static constexpr TextView TERMINATORS{"/:x \xff\xfa\x00.", 8};
+  for (int i = 0; i < 20000; ++i) {
+    std::string s;
+    auto n = i % 26;
+    for (int k = 0; k < n; ++k) {
+      s += char('0' + rng() % 10);
+    }
+    s += TERMINATORS[rng() % TERMINATORS.size()];
+    for (int k = rng() % 10; k > 0; --k) {
+      s += char('0' + rng() % 10);
+    }
+    size_t expected_n;
+    TextView text{s};
+    auto expected = ref(text, expected_n);
+    REQUIRE(swoc::svto_radix<10>(text) == expected);
+    REQUIRE(text.data() == s.data() + expected_n);
+
+    if (isspace(s[0])) { // skipped by svtou.
+      continue;
+    }
+    TextView parsed;
+    REQUIRE(swoc::svtou(s, &parsed, 10) == expected);
+    REQUIRE(parsed.size() == expected_n);
+    if (expected < uintmax_t(std::numeric_limits<intmax_t>::max())) {
+      REQUIRE(swoc::svtoi("-" + s, &parsed, 10) == -intmax_t(expected));
+      REQUIRE(parsed.size() == (expected_n ? expected_n + 1 : 0));
+    }
+  }
+
+  // Values either side of overflow.
+  TextView x{"18446744073709551615 "};
+  REQUIRE(MAX == swoc::svto_radix<10>(x));
+  REQUIRE(x == " ");
+  x = "1844674407370955161500000";
+  REQUIRE(MAX == swoc::svto_radix<10>(x));
+  REQUIRE(x.empty());
+  x = "00000000000000000000000000012345678";
+  REQUIRE(12345678 == swoc::svto_radix<10>(x));
+  REQUIRE(x.empty());
+  x = "99999999";
+  REQUIRE(99999999 == swoc::svto_radix<10>(x));
+}
+
+TEST_CASE("TextView svtod", "[libswoc][TextView][svtod]")
+{
+  // Bit for bit comparison with the library, which is required to be correctly rounded.
+  auto check = [](TextView text) -> void {
+    std::string s{text};
+    double expected = strtod(s.c_str(), nullptr);
+    double actual   = swoc::svtod(text);
+    INFO("svtod(\"" << text << "\") " << std::setprecision(17) << actual << " strtod " << expected);
+    REQUIRE(0 == memcmp(&expected, &actual, sizeof(double)));
+  };
+
+  for (auto text : {"0"_tv, "-0"_tv, "1"_tv, "0.1"_tv, "1e23"_tv, "9007199254740993"_tv, "9007199254740992.5"_tv,
+                    "1.7976931348623157e308"_tv, "1.7976931348623159e308"_tv, "2.2250738585072011e-308"_tv,
+                    "2.2250738585072014e-308"_tv, "4.9e-324"_tv, "2.4703282292062327e-324"_tv, "2.4703282292062328e-324"_tv,
+                    "1e-400"_tv, "1e400"_tv, "7.038531e-26"_tv, "0.1000000000000000055511151231257827021181583404541015625"_tv,
+                    "0.1000000000000000055511151231257827021181583404541015624"_tv,
+                    "0.1000000000000000055511151231257827021181583404541015626"_tv, "123456789012345678901234567890"_tv,
+                    "00000000000000000000000000001.5"_tv, "0.00000000000000000000000000000000000001"_tv,
+                    "9223372036854775807"_tv, "18446744073709551615"_tv, "18446744073709551616"_tv, "1e-22"_tv,
+                    "1e22"_tv, "4503599627370496.5"_tv, "4503599627370497.5"_tv, "3.0000000000000004"_tv}) {
+    check(text);
+  }
+
+  // Random values printed at various precisions.
+  std::mt19937_64 rng(0x1337);
+  char buff[64];
+  for (int i = 0; i < 100000; ++i) {
+    uint64_t bits = rng();
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    if (!std::isfinite(d)) {
+      continue;
+    }
+    snprintf(buff, sizeof(buff), "%.*g", int(i % 20) + 1, d);
+    check(buff);
+  }
+  // Random digit strings with exponents, including long ones to exercise the fallback.
+  for (int i = 0; i < 100000; ++i) {
+    std::string s;
+    auto n = rng() % 30 + 1;
+    for (unsigned k = 0; k < n; ++k) {
+      s += char('0' + rng() % 10);
+    }
+    if (i % 3) {
+      s.insert(rng() % s.size(), 1, '.');
+    }
+    s += "e" + std::to_string(int(rng() % 700) - 350);
+    check(s);
+  }
+
+  // Parsed text.
+  TextView parsed;
+  REQUIRE(-1.5 == swoc::svtod("-1.5e", &parsed));
+  REQUIRE(parsed == "-1.5");
+  REQUIRE(150 == swoc::svtod("1.5e+2x", &parsed));
+  REQUIRE(parsed == "1.5e+2");
+  REQUIRE(5 == swoc::svtod("5.", &parsed));
+  REQUIRE(parsed == "5.");
+  REQUIRE(0.5 == swoc::svtod(".5,", &parsed));
+  REQUIRE(parsed == ".5");
+  REQUIRE(-7 == swoc::svtod("-7", &parsed));
+  REQUIRE(parsed == "-7");
+  REQUIRE(0 == swoc::svtod("-.e5", &parsed));
+  REQUIRE(parsed.empty());
+  REQUIRE(0 == swoc::svtod("", &parsed));
+  REQUIRE(parsed.empty());
+  REQUIRE(0 == swoc::svtod("x1", &parsed));
+  REQUIRE(parsed.empty());
+}
+
 TEST_CASE("TransformView", "[libswoc][TransformView]")
 {
   std::string_view source{"Evil Dave Rulz"};
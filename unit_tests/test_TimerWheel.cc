@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright Apache Software Foundation 2019
+/** @file
+
+    TimerWheel unit tests.
+*/
+
+#include <random>
+#include <vector>
+
+#include "swoc/TimerWheel.h"
+#include "catch.hpp"
+
+using swoc::TimerWheel;
+
+namespace
+{
+struct Timer {
+  uint64_t _expiry;
+  uint64_t _fired{0}; ///< Tick when returned from the wheel, or 1 if erased.
+  Timer *_next{nullptr};
+  Timer *_prev{nullptr};
+
+  explicit Timer(uint64_t expiry) : _expiry(expiry) {}
+
+  struct Linkage : swoc::IntrusiveLinkage<Timer> {
+    static uint64_t
+    key_of(Timer *t)
+    {
+      return t->_expiry;
+    }
+  };
+};
+
+} // namespace
+
+TEST_CASE("TimerWheel", "[libswoc][TimerWheel]")
+{
+  TimerWheel<Timer::Linkage> wheel(1000);
+  std::vector<Timer> timers;
+  for (uint64_t x : {990, 1000, 1001, 1255, 1256, 70000, 1001}) {
+    timers.emplace_back(x);
+  }
+  for (auto &t : timers) {
+    wheel.insert(&t);
+  }
+  REQUIRE(wheel.count() == 7);
+
+  // Already expired.
+  auto expired = wheel.advance(1000);
+  REQUIRE(expired.count() == 2);
+  REQUIRE(wheel.count() == 5);
+
+  wheel.erase(&timers[6]);
+  REQUIRE(wheel.count() == 4);
+  expired = wheel.advance(1001);
+  REQUIRE(expired.count() == 1);
+  REQUIRE(expired.head() == &timers[2]);
+
+  expired = wheel.advance(1255);
+  REQUIRE(expired.count() == 1);
+  REQUIRE(expired.head() == &timers[3]);
+  wheel.erase(&timers[5]); // in a higher level.
+  expired = wheel.advance(100000);
+  REQUIRE(expired.count() == 1);
+  REQUIRE(expired.head() == &timers[4]);
+  REQUIRE(wheel.count() == 0);
+
+  // Nothing in the wheel, should skip directly.
+  expired = wheel.advance(uint64_t(1) << 62);
+  REQUIRE(expired.empty());
+  REQUIRE(wheel.now() == uint64_t(1) << 62);
+}
+
+TEST_CASE("TimerWheel Far", "[libswoc][TimerWheel]")
+{
+  // Advancing a long way must skip the empty ticks, otherwise this would not finish.
+  TimerWheel<Timer::Linkage> wheel;
+  static constexpr uint64_t FAR = (uint64_t(1) << 40) + 5;
+  Timer near{100};
+  Timer far{FAR};
+  Timer farther{uint64_t(1) << 60};
+  wheel.insert(&far).insert(&near).insert(&farther);
+
+  auto expired = wheel.advance(FAR - 1);
+  REQUIRE(expired.count() == 1);
+  REQUIRE(expired.head() == &near);
+  REQUIRE(wheel.now() == FAR - 1);
+  REQUIRE(wheel.count() == 2);
+
+  expired = wheel.advance(FAR);
+  REQUIRE(expired.count() == 1);
+  REQUIRE(expired.head() == &far);
+
+  expired = wheel.advance(~uint64_t(0));
+  REQUIRE(expired.count() == 1);
+  REQUIRE(expired.head() == &farther);
+  REQUIRE(wheel.count() == 0);
+
+  // Full 64 bit range, no overflow list.
+  TimerWheel<Timer::Linkage, 8, 8> wide;
+  Timer t1{100};
+  Timer t2{FAR};
+  wide.insert(&t2).insert(&t1);
+  expired = wide.advance(FAR);
+  REQUIRE(expired.count() == 2);
+  REQUIRE(expired.head() == &t1);
+}
+
+TEST_CASE("TimerWheel Random", "[libswoc][TimerWheel]")
+{
+  // Small levels so that cascading and overflow are exercised.
+  using Wheel                 = TimerWheel<Timer::Linkage, 2, 3>;
+  static constexpr unsigned N = 5000;
+  std::minstd_rand rng(17);
+
+  Wheel wheel(12345);
+  std::vector<Timer> timers;
+  timers.reserve(2 * N); // no reallocation, the wheel has pointers to the elements.
+  for (unsigned i = 0; i < N; ++i) {
+    wheel.insert(&timers.emplace_back(wheel.now() + 1 + rng() % 1000));
+  }
+
+  size_t n_fired  = 0;
+  size_t n_erased = 0;
+  bool valid_p    = true;
+  uint64_t prior  = wheel.now();
+  while (wheel.count()) {
+    auto now = wheel.now() + 1 + rng() % 20;
+    for (auto &t : wheel.advance(now)) {
+      valid_p = valid_p && t._expiry <= now && t._expiry > prior && t._fired == 0;
+      t._fired = now;
+      ++n_fired;
+    }
+    prior = now;
+    // Cancel a few, and add some more while running.
+    for (unsigned i = 0; i < 3; ++i) {
+      auto &t = timers[rng() % timers.size()];
+      if (t._fired == 0) { // every timer not fired or erased is in the wheel.
+        wheel.erase(&t);
+        t._fired = 1;
+        ++n_erased;
+      }
+    }
+    if (timers.size() < timers.capacity()) {
+      wheel.insert(&timers.emplace_back(now + 1 + rng() % 5000));
+    }
+  }
+  REQUIRE(valid_p);
+  REQUIRE(n_fired + n_erased == timers.size());
+}
@@ -0,0 +1,185 @@
+/** @file
+
+    Hash function unit tests.
+
+    @section license License
+
+    Licensed to the Apache Software Foundation (ASF) under one or more contributor license
+    agreements.  See the NOTICE file distributed with this work for additional information regarding
+    copyright ownership.  The ASF licenses this file to you under the Apache License, Version 2.0
+    (the "License"); you may not use this file except in compliance with the License.  You may
+    obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software distributed under the
+    License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+    express or implied. See the License for the specific language governing permissions and
+    limitations under the License.
+*/
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "swoc/ext/HashFNV.h"
+#include "swoc/ext/HashWy.h"
+#include "catch.hpp"
+
+using swoc::TextView;
+
+namespace {
+// Reference wyhash final4, one shot, transcribed from the original.
+uint64_t const WyP[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull};
+
+void
+wymum(uint64_t *A, uint64_t *B) {
+  __uint128_t r = *A;
+  r *= *B;
+  *A = uint64_t(r);
+  *B = uint64_t(r >> 64);
+}
+
+uint64_t
+wymix(uint64_t A, uint64_t B) {
+  wymum(&A, &B);
+  return A ^ B;
+}
+
+uint64_t
+wyr8(uint8_t const *p) {
+  uint64_t v;
+  memcpy(&v, p, 8);
+  return v;
+}
+
+uint64_t
+wyr4(uint8_t const *p) {
+  uint32_t v;
+  memcpy(&v, p, 4);
+  return v;
+}
+
+uint64_t
+wyhash(void const *key, size_t len, uint64_t seed) {
+  auto p = static_cast<uint8_t const *>(key);
+  seed ^= wymix(seed ^ WyP[0], WyP[1]);
+  uint64_t a, b;
+  if (len <= 16) {
+    if (len >= 4) {
+      a = (wyr4(p) << 32) | wyr4(p + ((len >> 3) << 2));
+      b = (wyr4(p + len - 4) << 32) | wyr4(p + len - 4 - ((len >> 3) << 2));
+    } else if (len > 0) {
+      a = (uint64_t(p[0]) << 16) | (uint64_t(p[len >> 1]) << 8) | p[len - 1];
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t i = len;
+    if (i > 48) {
+      uint64_t see1 = seed, see2 = seed;
+      do {
+        seed = wymix(wyr8(p) ^ WyP[1], wyr8(p + 8) ^ seed);
+        see1 = wymix(wyr8(p + 16) ^ WyP[2], wyr8(p + 24) ^ see1);
+        see2 = wymix(wyr8(p + 32) ^ WyP[3], wyr8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16) {
+      seed = wymix(wyr8(p) ^ WyP[1], wyr8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = wyr8(p + i - 16);
+    b = wyr8(p + i - 8);
+  }
+  a ^= WyP[1];
+  b ^= seed;
+  wymum(&a, &b);
+  return wymix(a ^ WyP[0] ^ len, b ^ WyP[1]);
+}
+} // namespace
+
+TEST_CASE("Hash64Wy", "[libswoc][hash]")
+{
+  std::string text;
+  std::mt19937_64 rng(0x5EED);
+  for (int i = 0; i < 400; ++i) {
+    text += char(rng());
+  }
+
+  // Every length through several blocks, fed in one piece and in random pieces.
+  for (size_t n = 0; n < text.size(); ++n) {
+    TextView src{text.data(), n};
+    auto expected = wyhash(src.data(), n, 0);
+    REQUIRE(swoc::Hash64Wy().hash_immediate(src) == expected);
+    REQUIRE(swoc::Hash64Wy(n).hash_immediate(src) == wyhash(src.data(), n, n));
+
+    swoc::Hash64Wy h;
+    for (TextView v = src; v;) {
+      auto k = rng() % 70;
+      h.update(v.prefix(k));
+      v.remove_prefix(k);
+    }
+    REQUIRE(h.final().get() == expected);
+    REQUIRE(h.clear().update(src).final().get() == expected);
+  }
+
+  std::string upper{"A MIXED case STRING which is longer than a single block of input."};
+  std::string lower{upper};
+  for (auto &c : lower) {
+    c = tolower(c);
+  }
+  REQUIRE(swoc::Hash64Wy().hash_immediate(swoc::transform_view_of(&tolower, TextView{upper})) ==
+          swoc::Hash64Wy().hash_immediate(lower));
+}
+
+TEST_CASE("Hash nocase", "[libswoc][hash]")
+{
+  // Every byte value, including the neighbors of the letter ranges and non-ASCII.
+  std::string text;
+  std::mt19937 rng(0x5EED);
+  for (int i = 0; i < 300; ++i) {
+    text += char(i < 256 ? i : rng());
+  }
+  std::string lower{text};
+  for (auto &c : lower) {
+    c = ('A' <= c && c <= 'Z') ? c + ('a' - 'A') : c;
+  }
+
+  for (size_t n = 0; n < text.size(); n += 1 + n / 8) {
+    for (size_t off : {0, 1, 7}) {
+      TextView src{text.data() + off, n}, ref{lower.data() + off, n};
+      REQUIRE(swoc::Hash32FNV1a().hash_immediate_nocase(src) == swoc::Hash32FNV1a().hash_immediate(ref));
+      REQUIRE(swoc::Hash64FNV1a().hash_immediate_nocase(src) == swoc::Hash64FNV1a().hash_immediate(ref));
+      REQUIRE(swoc::Hash64Wy().hash_immediate_nocase(src) == swoc::Hash64Wy().hash_immediate(ref));
+      REQUIRE(swoc::Hash64Wy().hash_immediate_nocase(src) ==
+              swoc::Hash64Wy().hash_immediate(swoc::transform_view_of(&tolower, src)));
+    }
+  }
+}
+
+TEST_CASE("Hash distribution", "[libswoc][hash]")
+{
+  // Similar keys should be spread evenly across buckets.
+  static constexpr size_t N_BUCKETS = 1024;
+  static constexpr size_t N_KEYS    = 64 * N_BUCKETS;
+  std::vector<unsigned> buckets(N_BUCKETS);
+  char key[64];
+  for (size_t i = 0; i < N_KEYS; ++i) {
+    auto n = snprintf(key, sizeof(key), "https://www.example.com/path/%zu", i);
+    ++buckets[swoc::Hash64Wy().hash_immediate(std::string_view(key, n)) % N_BUCKETS];
+  }
+  // Chi-squared, the expected value is the number of buckets with a standard deviation of about
+  // 45 - this is a very loose bound.
+  double chi   = 0;
+  double ideal = double(N_KEYS) / N_BUCKETS;
+  for (auto count : buckets) {
+    chi += (count - ideal) * (count - ideal) / ideal;
+  }
+  REQUIRE(chi < N_BUCKETS + 300);
+}
@@ -8,6 +8,7 @@
 #include "catch.hpp"
 
 #include <set>
+#include <unistd.h>
 
 #include "swoc/TextView.h"
 #include "swoc/swoc_ip.h"
@@ -15,6 +16,7 @@
 #include "swoc/bwf_std.h"
 #include "swoc/swoc_file.h"
 #include "swoc/Lexicon.h"
+#include "swoc/IPSpaceLoader.h"
 
 using namespace std::literals;
 using namespace swoc::literals;
@@ -642,6 +644,112 @@ TEST_CASE("IP ranges and networks", "[libswoc][ip][net][range]") {
   }
 }
 
+TEST_CASE("IP range network decomposition", "[libswoc][ip][net][range]") {
+  using swoc::IP4Net;
+  using swoc::IP6Net;
+  using swoc::IPNet;
+
+  std::array<IP4Net, IP4Range::MAX_NETWORKS> nets4;
+  std::array<IP6Net, IP6Range::MAX_NETWORKS> nets6;
+  std::array<IPNet, IPRange::MAX_NETWORKS> nets;
+
+  REQUIRE(IP4Range{}.networks(nets4) == 0);
+  REQUIRE(IPRange{}.networks(nets) == 0);
+  REQUIRE(IPRange{IP4Range{}}.empty());
+  REQUIRE(IPRange{IP4Range{}}.networks(nets) == 0);
+  REQUIRE(IPRange{IP6Range{}}.empty());
+  REQUIRE(IPRange{IP6Range{}}.networks(nets) == 0);
+
+  // Check the buffer result agrees with the network generator.
+  auto check4 = [&](IP4Range const &r) -> bool {
+    auto n = r.networks(nets4);
+    size_t idx = 0;
+    for (auto const &net : r.networks()) {
+      if (idx >= n || !(nets4[idx] == net)) {
+        return false;
+      }
+      ++idx;
+    }
+    if (idx != n || IPRange{r}.networks(nets) != n) {
+      return false;
+    }
+    for (idx = 0; idx < n; ++idx) {
+      if (!(nets[idx] == IPNet{IPAddr{nets4[idx].lower_bound()}, nets4[idx].mask()})) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  auto check6 = [&](IP6Range const &r) -> bool {
+    auto n = r.networks(nets6);
+    size_t idx = 0;
+    for (auto const &net : r.networks()) {
+      if (idx >= n || !(nets6[idx] == net)) {
+        return false;
+      }
+      ++idx;
+    }
+    if (idx != n || IPRange{r}.networks(nets) != n) {
+      return false;
+    }
+    for (idx = 0; idx < n; ++idx) {
+      if (!(nets[idx] == IPNet{IPAddr{nets6[idx].lower_bound()}, nets6[idx].mask()})) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  IP4Range r_4{"10.33.45.19-10.33.45.76"};
+  REQUIRE(r_4.networks(nets4) == 7);
+  CHECK(nets4[0] == IP4Net{"10.33.45.19/32"});
+  CHECK(nets4[3] == IP4Net{"10.33.45.32/27"});
+  CHECK(nets4[6] == IP4Net{"10.33.45.76/32"});
+  CHECK(check4(r_4));
+
+  // Short buffer - only the leading networks are written but the full count is returned.
+  nets4[2] = IP4Net{};
+  REQUIRE(r_4.networks(swoc::MemSpan<IP4Net>{nets4.data(), 2}) == 7);
+  CHECK(nets4[1] == IP4Net{"10.33.45.20/30"});
+  CHECK(nets4[2] == IP4Net{});
+
+  // Boundary cases.
+  REQUIRE(IP4Range{IP4Addr::MIN, IP4Addr::MAX}.networks(nets4) == 1);
+  CHECK(nets4[0].mask().width() == 0);
+  REQUIRE(IP4Range{"255.255.255.255"}.networks(nets4) == 1);
+  CHECK(nets4[0] == IP4Net{"255.255.255.255/32"});
+  REQUIRE(IP4Range{"0.0.0.1-255.255.255.254"}.networks(nets4) == IP4Range::MAX_NETWORKS);
+  CHECK(check4(IP4Range{"0.0.0.1-255.255.255.254"}));
+  CHECK(check4(IP4Range{"128.0.0.0-255.255.255.255"}));
+
+  REQUIRE(IP6Range{IP6Addr::MIN, IP6Addr::MAX}.networks(nets6) == 1);
+  CHECK(nets6[0].mask().width() == 0);
+  REQUIRE(IP6Range{"::1-ffff:ffff:ffff:ffff:ffff:ffff:ffff:fffe"}.networks(nets6) == IP6Range::MAX_NETWORKS);
+  CHECK(check6(IP6Range{"::1-ffff:ffff:ffff:ffff:ffff:ffff:ffff:fffe"}));
+  // Crossing the word boundary.
+  REQUIRE(IP6Range{"1::ffff:ffff:ffff:ffff-1:0:0:1::"}.networks(nets6) == 2);
+  CHECK(nets6[0] == IP6Net{IP6Addr{"1::ffff:ffff:ffff:ffff"}, IPMask{128}});
+  CHECK(nets6[1] == IP6Net{IP6Addr{"1:0:0:1::"}, IPMask{128}});
+  CHECK(check6(IP6Range{"2001:1f2d:c587:24c3:9128:3349:3cee:143-ffee:1f2d:c587:24c3:9128:3349:3cFF:FFFF"}));
+
+  // Pseudo-random ranges.
+  uint32_t x = 0x2545F491;
+  auto next  = [&]() -> uint32_t {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return x;
+  };
+  for (unsigned i = 0; i < 1000; ++i) {
+    uint32_t a = next(), b = next();
+    REQUIRE(check4(IP4Range{IP4Addr{std::min(a, b)}, IP4Addr{std::max(a, b)}}));
+    IP6Addr a6{W().print("{:x}::{:x}:{:x}", next() & 0xFFFF, next() & 0xFFFF, next() & 0xFFFF).view()};
+    IP6Addr b6{W().print("{:x}::{:x}:{:x}", next() & 0xFFFF, next() & 0xFFFF, next() & 0xFFFF).view()};
+    REQUIRE(check6(IP6Range{std::min(a6, b6), std::max(a6, b6)}));
+  }
+}
+
 TEST_CASE("IP Space Int", "[libswoc][ip][ipspace]") {
   using uint_space = swoc::IPSpace<unsigned>;
   uint_space space;
@@ -1738,3 +1846,226 @@ TEST_CASE("IPSpace fill", "[libswoc][ipspace][fill]") {
   }
 }
 
+
+TEST_CASE("IPSpace hits", "[libswoc][ipspace][hits]") {
+  using Space = swoc::IPSpace<unsigned>;
+  Space space;
+
+  space.mark(IPRange{"10.0.0.0/8"}, 1);
+  space.mark(IPRange{"172.16.0.0/12"}, 2);
+  space.mark(IPRange{"2001:db8::/32"}, 3);
+
+  // Not counting by default.
+  REQUIRE(false == space.is_hit_counting());
+  space.find(IPAddr{"10.1.1.1"});
+  for (auto &&[r, p, hits] : space.hits()) {
+    REQUIRE(hits == 0);
+  }
+
+  space.set_hit_counting(true);
+  REQUIRE(true == space.is_hit_counting());
+  for (unsigned i = 0; i < 5; ++i) {
+    space.find(IPAddr{"10.1.1.1"});
+  }
+  space.find(IPAddr{"2001:db8::1"});
+  space.find(IPAddr{"192.168.1.1"}); // miss, no count.
+
+  std::array<uint64_t, 4> counts{0, 0, 0, 0};
+  unsigned n = 0;
+  for (auto &&[r, p, hits] : space.hits()) {
+    REQUIRE(false == r.empty());
+    counts[p] = hits;
+    ++n;
+  }
+  REQUIRE(n == space.count());
+  REQUIRE(counts[1] == 5);
+  REQUIRE(counts[2] == 0);
+  REQUIRE(counts[3] == 1);
+
+  // Post increment and decrement keep the hit count value type.
+  auto spot = space.hits().begin();
+  auto prior = spot++;
+  static_assert(std::is_same_v<Space::hit_iterator, decltype(spot--)>);
+  REQUIRE(std::get<2>(*prior) == 5);
+  REQUIRE(std::get<1>(*spot) == 2);
+  prior = spot--;
+  REQUIRE(std::get<1>(*prior) == 2);
+  REQUIRE(std::get<2>(*spot) == 5);
+
+  space.reset_hits();
+  for (auto &&[r, p, hits] : space.hits()) {
+    REQUIRE(hits == 0);
+  }
+
+  space.set_hit_counting(false);
+  space.find(IPAddr{"10.1.1.1"});
+  REQUIRE(space.begin().hits() == 0);
+}
+
+TEST_CASE("IPSpace diff", "[libswoc][ipspace][diff]") {
+  using Space = swoc::IPSpace<unsigned>;
+
+  auto load_v1 = [](Space &space) -> void {
+    space.mark(IPRange{"10.0.0.0/8"}, 1);
+    space.mark(IPRange{"172.16.0.0/12"}, 2);
+    space.mark(IPRange{"192.168.0.0-192.168.0.255"}, 3);
+    space.mark(IPRange{"192.168.1.0-192.168.1.255"}, 4);
+    space.mark(IPRange{"2001:db8::/32"}, 5);
+  };
+
+  Space v1;
+  Space v2;
+  load_v1(v1);
+  load_v1(v2);
+
+  REQUIRE(v1.diff(v2).empty());
+
+  v2.mark(IPRange{"10.1.0.0/16"}, 6);                  // split existing range.
+  v2.erase(IPRange{"172.16.0.0/12"});                  // drop a range.
+  v2.mark(IPRange{"192.168.0.0-192.168.1.255"}, 7);    // two ranges to one payload.
+  v2.mark(IPRange{"203.0.113.0/24"}, 8);               // new range.
+  v2.mark(IPRange{"2001:db8:1::/48"}, 9);              // IPv6 change.
+
+  auto diff = v1.diff(v2);
+  REQUIRE(diff.size() == 6);
+
+  REQUIRE(diff[0]._range == IPRange{"10.1.0.0/16"});
+  REQUIRE(diff[0]._prior == 1u);
+  REQUIRE(diff[0]._after == 6u);
+
+  REQUIRE(diff[1]._range == IPRange{"172.16.0.0/12"});
+  REQUIRE(diff[1]._prior == 2u);
+  REQUIRE(false == diff[1]._after.has_value());
+
+  // Different prior payloads, therefore two changes even though the new payload is the same.
+  REQUIRE(diff[2]._range == IPRange{"192.168.0.0/24"});
+  REQUIRE(diff[3]._range == IPRange{"192.168.1.0/24"});
+  REQUIRE(diff[3]._prior == 4u);
+  REQUIRE(diff[3]._after == 7u);
+
+  REQUIRE(diff[4]._range == IPRange{"203.0.113.0/24"});
+  REQUIRE(false == diff[4]._prior.has_value());
+  REQUIRE(diff[4]._after == 8u);
+
+  REQUIRE(diff[5]._range == IPRange{"2001:db8:1::/48"});
+
+  // Applying the diff must yield the updated space.
+  v1.apply(diff);
+  REQUIRE(v1.count() == v2.count());
+  REQUIRE(v1.diff(v2).empty());
+  auto spot = v2.begin();
+  for (auto &&[r, p] : v1) {
+    REQUIRE(r == std::get<0>(*spot));
+    REQUIRE(p == std::get<1>(*spot));
+    ++spot;
+  }
+
+  // Reverse.
+  Space v0;
+  load_v1(v0);
+  v1.apply(v2.diff(v0));
+  REQUIRE(v1.diff(v0).empty());
+
+  // To and from empty.
+  Space empty;
+  auto d = empty.diff(v0);
+  REQUIRE(d.size() == v0.count());
+  empty.apply(d);
+  REQUIRE(empty.diff(v0).empty());
+  empty.apply(v0.diff(Space{}));
+  REQUIRE(empty.count() == 0);
+
+  // Ranges that reach the maximum address.
+  Space all;
+  all.mark(IPRange{"0.0.0.0/0"}, 1);
+  all.mark(IPRange{"::/0"}, 1);
+  d = v0.diff(all);
+  REQUIRE(d.back()._range.ip6().max() == IP6Addr::MAX);
+  v0.apply(d);
+  REQUIRE(v0.count() == 2);
+  REQUIRE(v0.diff(all).empty());
+}
+
+TEST_CASE("IPSpace loader", "[libswoc][ipspace][loader]") {
+  using Space  = IPSpace<unsigned>;
+  using Loader = swoc::IPSpaceLoader<unsigned>;
+  Space space;
+
+  auto parser = [](TextView fields) -> swoc::Rv<unsigned> {
+    TextView parsed;
+    auto token = fields.take_prefix_at(',');
+    auto n     = swoc::svtou(token, &parsed);
+    if (token.empty() || parsed.size() != token.size()) {
+      return swoc::Errata(R"(Invalid value "{}".)", token);
+    }
+    return unsigned(n);
+  };
+
+  static constexpr TextView CONTENT = R"(# Test data.
+10.1.0.0/16, 1, first
+10.1.1.0-10.1.1.255 , 2
+
+  172.16.0.1,3,
+10.2.0.0/16,bogus
+2001:db8::/32,4, ipv6
+not-an-address,5
+1.2.3.4,6)";
+
+  Loader loader{space, parser};
+  auto errata = loader.load(CONTENT);
+  REQUIRE_FALSE(errata.is_ok());
+  REQUIRE(loader.line_count() == 9);
+  REQUIRE(loader.range_count() == 5);
+  REQUIRE(space.count() == 6);
+  CHECK(std::get<1>(*space.find(IPAddr{"10.1.2.1"})) == 1);
+  CHECK(std::get<1>(*space.find(IPAddr{"10.1.1.1"})) == 2);
+  CHECK(std::get<1>(*space.find(IPAddr{"172.16.0.1"})) == 3);
+  CHECK(std::get<1>(*space.find(IPAddr{"2001:db8::1"})) == 4);
+  CHECK(std::get<1>(*space.find(IPAddr{"1.2.3.4"})) == 6);
+  CHECK(space.find(IPAddr{"10.2.0.1"}) == space.end());
+
+  // Errors must carry the line numbers.
+  W w;
+  w.print("{}", errata);
+  CHECK(w.view().find("line 6") != TextView::npos);
+  CHECK(w.view().find("line 8") != TextView::npos);
+  CHECK(w.view().find("bogus") != TextView::npos);
+
+  // Fill mode should not overwrite, and the error limit should stop loading.
+  loader.mode(Loader::Mode::FILL).error_limit(1);
+  errata = loader.load("10.1.0.0/16,9\n10.3.0.0/16,9\nnope,1\n10.4.0.0/16,9\n");
+  REQUIRE_FALSE(errata.is_ok());
+  CHECK(loader.line_count() == 3);
+  CHECK(loader.range_count() == 2);
+  CHECK(std::get<1>(*space.find(IPAddr{"10.1.1.1"})) == 2);
+  CHECK(std::get<1>(*space.find(IPAddr{"10.1.2.1"})) == 1);
+  CHECK(std::get<1>(*space.find(IPAddr{"10.3.0.1"})) == 9);
+  CHECK(space.find(IPAddr{"10.4.0.1"}) == space.end());
+
+  // Load from a file, with a small block size so lines cross reads.
+  char tmp_name[] = "/tmp/libswoc_loader_XXXXXX";
+  int fd          = mkstemp(tmp_name);
+  REQUIRE(fd >= 0);
+  std::string content;
+  for (unsigned i = 0; i < 1000; ++i) {
+    content += W().print("10.{}.{}.0/24;{}\n", i / 256, i % 256, i).view();
+  }
+  REQUIRE(::write(fd, content.data(), content.size()) == ssize_t(content.size()));
+  ::close(fd);
+
+  Space fspace;
+  Loader floader{fspace, parser};
+  errata = floader.delimiter(';').load(swoc::file::path{tmp_name}, 64);
+  ::unlink(tmp_name);
+  REQUIRE(errata.is_ok());
+  REQUIRE(floader.line_count() == 1000);
+  REQUIRE(fspace.count() == 1000);
+  for (unsigned i = 0; i < 1000; i += 37) {
+    auto spot = fspace.find(IP4Addr{W().print("10.{}.{}.1", i / 256, i % 256).view()});
+    REQUIRE(spot != fspace.end());
+    CHECK(std::get<1>(*spot) == i);
+  }
+
+  errata = floader.load(swoc::file::path{"unit_tests/no_such_file.txt"});
+  REQUIRE_FALSE(errata.is_ok());
+}
@@ -85,3 +85,30 @@ TEST_CASE("swoc_file_io", "[libts][swoc_file_io]")
   REQUIRE(swoc::file::is_readable(file) == false);
 
 }
+
+TEST_CASE("swoc_file line_reader", "[libts][swoc_file_io]")
+{
+  path file("unit_tests/test_swoc_file.cc");
+  std::error_code ec;
+  std::string content = swoc::file::load(file, ec);
+  REQUIRE(ec.value() == 0);
+
+  // Use a small buffer so that lines span reads and the buffer has to grow.
+  swoc::file::line_reader reader{16};
+  REQUIRE(reader.open(file).value() == 0);
+  swoc::TextView expected{content};
+  swoc::TextView line;
+  size_t n = 0;
+  while (reader.next(line)) {
+    ++n;
+    REQUIRE(line == expected.take_prefix_at('\n'));
+    REQUIRE(reader.line_no() == n);
+  }
+  REQUIRE(expected.empty());
+  REQUIRE(reader.error().value() == 0);
+  REQUIRE(n > 100);
+
+  reader.close();
+  REQUIRE(reader.open(path("../unit-tests/no_such_file.txt")).value() == 2);
+  REQUIRE(reader.next(line) == false);
+}